@@ -0,0 +1,67 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Measures a memory-bound reduction with cold and warm caches, under each way of making the caches cold.
+
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "timer/cache.hpp"
+
+int main(int argc, char **argv) {
+    const std::size_t bytes = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4) << 20;
+    const std::size_t count = bytes / sizeof(double);
+
+    timer::CacheBenchmarkOptions options;
+    options.benchmark.iterations = 20;
+    options.benchmark.bytesPerIteration = bytes;
+
+    // Enough copies to exceed the last level cache between uses of the same copy
+    options.copies = std::max<std::size_t>(2 * timer::lastLevelCacheSize() / bytes + 1, 2);
+    std::vector<std::vector<double> > inputs(options.copies, std::vector<double>(count, 1.0));
+    options.buffers.push_back(timer::CacheBuffer{inputs.front().data(), bytes});
+
+    volatile double sink = 0.0;
+    const auto sum = [&](std::size_t copy) { sink = std::accumulate(inputs[copy].begin(), inputs[copy].end(), 0.0); };
+
+    std::cout << "summing " << (bytes >> 20) << " MiB, last level cache " << (timer::lastLevelCacheSize() >> 20)
+              << " MiB\n";
+    for (const auto mode: {timer::ColdCacheMode::FlushBuffers, timer::ColdCacheMode::EvictLastLevel,
+                           timer::ColdCacheMode::RotateCopies}) {
+        options.coldMode = mode;
+        std::cout << '\n' << (mode == timer::ColdCacheMode::FlushBuffers
+                                  ? "flush registered buffers"
+                                  : mode == timer::ColdCacheMode::EvictLastLevel
+                                        ? "evict last level cache"
+                                        : "rotate input copies") << ":\n";
+        timer::printCacheReport(std::cout, timer::cacheBenchmark(sum, options));
+    }
+    return 0;
+}
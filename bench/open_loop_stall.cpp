@@ -0,0 +1,58 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Drives a service that stalls periodically with an open-loop load, showing how much of the stall a closed-loop
+// measurement would hide.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "timer/open_loop.hpp"
+
+int main(int argc, char **argv) {
+    timer::OpenLoopOptions options;
+    options.rate = argc > 1 ? std::atof(argv[1]) : 5000.0;
+    options.requests = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+    const double stallMs = argc > 3 ? std::atof(argv[3]) : 20.0;
+
+    // About 50 us of work per request, and a stall on every thousandth
+    std::uint64_t calls = 0;
+    const auto service = [&] {
+        const bool stall = ++calls % 1000 == 0;
+        timer::sleep_for_precise(stall ? timer::Duration(stallMs * 1e-3) : timer::Duration(50e-6));
+    };
+
+    for (const auto schedule: {timer::ArrivalSchedule::Constant, timer::ArrivalSchedule::Poisson}) {
+        options.schedule = schedule;
+        std::cout << (schedule == timer::ArrivalSchedule::Constant ? "constant" : "poisson") << " arrivals at "
+                  << options.rate << " requests/s, " << stallMs << " ms stall every 1000 requests\n";
+        timer::printOpenLoopReport(std::cout, timer::time_open_loop(service, options));
+        std::cout << '\n';
+    }
+    return 0;
+}
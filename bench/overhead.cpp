@@ -0,0 +1,290 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Measures the per-call overhead of the library's own instrumentation, in TSC cycles and nanoseconds, at several
+// thread counts:
+//
+//     simple-timer-bench [--calls N] [--threads 1,2,4] [--csv | --json]
+//
+// The CSV and JSON outputs are meant to be stored and compared between builds, so overhead regressions are caught.
+// The "TraceBuffer disabled" cases use a buffer switched off with setEnabled(false). Instrumentation is never compiled
+// out, and timer::time has no disabled variant, so this is the cheapest the library gets.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "timer/clocks.hpp"
+#include "timer/environment.hpp"
+#include "timer/histogram.hpp"
+#include "timer/parallel.hpp"
+#include "timer/trace.hpp"
+
+namespace {
+    // Keeps a value alive without letting the compiler reason about it
+    template<typename T>
+    inline void keep(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile char sink;
+        sink = *reinterpret_cast<const volatile char *>(&value);
+#endif
+    }
+
+    // Everything a case needs on one thread. Histograms and trace buffers have a single writer, so each thread has
+    // its own.
+    struct ThreadState {
+        timer::Histogram histogram;
+        timer::TraceBuffer trace{4096};
+        timer::TraceBuffer disabledTrace{4096};
+
+        ThreadState() { disabledTrace.setEnabled(false); }
+    };
+
+    struct Case {
+        const char *name;
+        std::function<void(ThreadState &, std::size_t)> run;
+    };
+
+    struct Measurement {
+        std::string name;
+        unsigned threads;
+        double cyclesPerCall;
+        double nanosecondsPerCall;
+    };
+
+    std::vector<Case> cases() {
+        std::vector<Case> all;
+        all.push_back({"empty loop", [](ThreadState &, std::size_t calls) {
+            for (std::size_t i = 0; i < calls; ++i) {
+                keep(i);
+            }
+        }});
+        all.push_back({"time(void)", [](ThreadState &, std::size_t calls) {
+            for (std::size_t i = 0; i < calls; ++i) {
+                keep(timer::time([] {}).duration);
+            }
+        }});
+        all.push_back({"time(non-void)", [](ThreadState &, std::size_t calls) {
+            for (std::size_t i = 0; i < calls; ++i) {
+                keep(timer::time([i] { return i; }).functionResult);
+            }
+        }});
+        all.push_back({"timer::now", [](ThreadState &, std::size_t calls) {
+            for (std::size_t i = 0; i < calls; ++i) {
+                keep(timer::now());
+            }
+        }});
+        all.push_back({"steady_clock ticks", [](ThreadState &, std::size_t calls) {
+            for (std::size_t i = 0; i < calls; ++i) {
+                keep(timer::SteadyClockBackend::ticks());
+            }
+        }});
+        all.push_back({"tsc ticks", [](ThreadState &, std::size_t calls) {
+            for (std::size_t i = 0; i < calls; ++i) {
+                keep(timer::TscClockBackend::ticks());
+            }
+        }});
+        all.push_back({"thread_cpu ticks", [](ThreadState &, std::size_t calls) {
+            for (std::size_t i = 0; i < calls; ++i) {
+                keep(timer::ThreadCpuClockBackend::ticks());
+            }
+        }});
+#ifdef BUILD_WITH_MPI
+        all.push_back({"MPI_Wtime ticks", [](ThreadState &, std::size_t calls) {
+            for (std::size_t i = 0; i < calls; ++i) {
+                keep(timer::MpiClockBackend::ticks());
+            }
+        }});
+#endif
+        all.push_back({"ScopedTrace", [](ThreadState &state, std::size_t calls) {
+            for (std::size_t i = 0; i < calls; ++i) {
+                timer::ScopedTrace trace(state.trace, "scope");
+            }
+        }});
+        all.push_back({"ScopedTrace, TraceBuffer disabled", [](ThreadState &state, std::size_t calls) {
+            for (std::size_t i = 0; i < calls; ++i) {
+                timer::ScopedTrace trace(state.disabledTrace, "scope");
+            }
+        }});
+        all.push_back({"TraceBuffer::emit", [](ThreadState &state, std::size_t calls) {
+            const timer::TimePoint at = timer::now();
+            for (std::size_t i = 0; i < calls; ++i) {
+                state.trace.emit("event", at, at);
+            }
+        }});
+        all.push_back({"emit, TraceBuffer disabled", [](ThreadState &state, std::size_t calls) {
+            const timer::TimePoint at = timer::now();
+            for (std::size_t i = 0; i < calls; ++i) {
+                state.disabledTrace.emit("event", at, at);
+            }
+        }});
+        all.push_back({"Histogram::record", [](ThreadState &state, std::size_t calls) {
+            for (std::size_t i = 0; i < calls; ++i) {
+                state.histogram.record(static_cast<std::uint64_t>(i & 0xffff));
+            }
+        }});
+        return all;
+    }
+
+    // The best of a few repetitions of the median per-call cost across threads
+    Measurement measure(const Case &benchCase, unsigned threads, std::size_t calls, timer::BenchmarkThreadPool &pool) {
+        std::vector<std::unique_ptr<ThreadState> > states;
+        for (unsigned i = 0; i < threads; ++i) {
+            states.push_back(std::make_unique<ThreadState>());
+        }
+
+        Measurement best{benchCase.name, threads, 0.0, 0.0};
+        for (int repetition = 0; repetition < 3; ++repetition) {
+            std::vector<double> cycles(threads);
+            std::vector<double> nanoseconds(threads);
+            timer::time_parallel(pool, threads, [&](unsigned thread) {
+                const std::uint64_t startTicks = timer::TscClockBackend::ticks();
+                const timer::TimePoint start = timer::SteadyClockBackend::now();
+                benchCase.run(*states[thread], calls);
+                const timer::TimePoint end = timer::SteadyClockBackend::now();
+                cycles[thread] = static_cast<double>(timer::TscClockBackend::ticks() - startTicks) / calls;
+                nanoseconds[thread] = timer::nanoseconds(end - start).count() / calls;
+            });
+
+            std::sort(cycles.begin(), cycles.end());
+            std::sort(nanoseconds.begin(), nanoseconds.end());
+            const double medianNanoseconds = nanoseconds[threads / 2];
+            if (repetition == 0 || medianNanoseconds < best.nanosecondsPerCall) {
+                best.cyclesPerCall = cycles[threads / 2];
+                best.nanosecondsPerCall = medianNanoseconds;
+            }
+        }
+        return best;
+    }
+
+    std::string jsonEscape(const std::string &text) {
+        std::string escaped;
+        for (const char c: text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    std::vector<unsigned> parseThreads(const char *list) {
+        std::vector<unsigned> threads;
+        std::stringstream stream(list);
+        for (std::string item; std::getline(stream, item, ',');) {
+            const auto count = static_cast<unsigned>(std::atoi(item.c_str()));
+            if (count > 0) {
+                threads.push_back(count);
+            }
+        }
+        return threads;
+    }
+}
+
+int main(int argc, char **argv) {
+    std::size_t calls = 1000000;
+    std::vector<unsigned> threadCounts;
+    enum class Format { Table, Csv, Json } format = Format::Table;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--calls") == 0 && i + 1 < argc) {
+            calls = std::max<std::size_t>(std::strtoull(argv[++i], nullptr, 10), 1);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCounts = parseThreads(argv[++i]);
+        } else if (std::strcmp(argv[i], "--csv") == 0) {
+            format = Format::Csv;
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            format = Format::Json;
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--calls N] [--threads 1,2,4] [--csv | --json]\n";
+            return 2;
+        }
+    }
+
+    // By default, powers of two up to the number of cores, and the number of cores itself
+    if (threadCounts.empty()) {
+        const unsigned cores = std::max(std::thread::hardware_concurrency(), 1u);
+        for (unsigned count = 1; count < cores; count *= 2) {
+            threadCounts.push_back(count);
+        }
+        threadCounts.push_back(cores);
+    }
+
+    timer::BenchmarkThreadPool pool(*std::max_element(threadCounts.begin(), threadCounts.end()));
+    std::vector<Measurement> measurements;
+    for (const Case &benchCase: cases()) {
+        for (const unsigned threads: threadCounts) {
+            measurements.push_back(measure(benchCase, threads, calls, pool));
+        }
+    }
+
+    const std::string environment = timer::describeEnvironment(timer::currentEnvironment());
+    switch (format) {
+        case Format::Csv:
+            std::cout << "case,threads,cycles_per_call,ns_per_call\n";
+            for (const Measurement &measurement: measurements) {
+                std::cout << '"' << measurement.name << "\"," << measurement.threads << ','
+                          << measurement.cyclesPerCall << ',' << measurement.nanosecondsPerCall << '\n';
+            }
+            break;
+        case Format::Json:
+            std::cout << "{\n  \"environment\": \"" << jsonEscape(environment) << "\",\n  \"calls\": " << calls
+                      << ",\n  \"results\": [\n";
+            for (std::size_t i = 0; i < measurements.size(); ++i) {
+                const Measurement &measurement = measurements[i];
+                std::cout << "    {\"case\": \"" << jsonEscape(measurement.name) << "\", \"threads\": "
+                          << measurement.threads << ", \"cycles_per_call\": " << measurement.cyclesPerCall
+                          << ", \"ns_per_call\": " << measurement.nanosecondsPerCall << '}'
+                          << (i + 1 < measurements.size() ? ",\n" : "\n");
+            }
+            std::cout << "  ]\n}\n";
+            break;
+        case Format::Table:
+            timer::printEnvironmentHeader(std::cout);
+            std::cout << std::left << std::setw(36) << "case" << std::right << std::setw(9) << "threads"
+                      << std::setw(16) << "cycles (tsc)" << std::setw(12) << "ns" << '\n';
+            for (const Measurement &measurement: measurements) {
+                std::cout << std::left << std::setw(36) << measurement.name << std::right
+                          << std::setw(9) << measurement.threads
+                          << std::setw(16) << std::fixed << std::setprecision(2) << measurement.cyclesPerCall
+                          << std::setw(12) << measurement.nanosecondsPerCall << '\n';
+            }
+            break;
+    }
+    return 0;
+}
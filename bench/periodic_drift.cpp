@@ -0,0 +1,64 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Compares the drift of a sleep_for(period) loop with a PeriodicExecutor, and prints the executor's jitter.
+
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include "timer/periodic.hpp"
+
+int main(int argc, char **argv) {
+    const double rateHz = argc > 1 ? std::atof(argv[1]) : 1000.0;
+    const std::uint64_t periods = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000;
+    const timer::Duration period(1.0 / rateHz);
+    const timer::Duration expected = period * static_cast<double>(periods);
+
+    timer::TimePoint start = timer::SteadyClockBackend::now();
+    for (std::uint64_t i = 0; i < periods; ++i) {
+        std::this_thread::sleep_for(std::chrono::duration_cast<timer::Clock::duration>(period));
+    }
+    const timer::Duration naive = timer::SteadyClockBackend::now() - start;
+
+    timer::PeriodicOptions options;
+    options.realtime = true;
+    timer::PeriodicExecutor executor(period, options);
+    start = timer::SteadyClockBackend::now();
+    const timer::PeriodicStats stats = executor.run([] {}, periods + 1);
+    const timer::Duration scheduled = timer::SteadyClockBackend::now() - start;
+
+    std::cout << periods << " periods at " << rateHz << " Hz, expected " << timer::milliseconds(expected).count()
+              << " ms\n"
+              << "  sleep_for loop drift:     " << timer::milliseconds(naive - expected).count() << " ms\n"
+              << "  PeriodicExecutor drift:   " << timer::milliseconds(scheduled - expected).count() << " ms"
+              << (stats.realtime ? " (SCHED_FIFO)" : "") << '\n'
+              << "  skipped " << stats.skipped << ", overruns " << stats.overruns << "\n\nexecutor jitter:\n";
+    stats.jitter.printSummary(std::cout);
+    return 0;
+}
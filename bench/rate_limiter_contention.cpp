@@ -0,0 +1,105 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Compares a mutex-protected token bucket with the lock-free GCRA RateLimiter under contention from many threads.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+#include "timer/parallel.hpp"
+#include "timer/rate_limiter.hpp"
+
+namespace {
+    // The conventional design the RateLimiter replaces: refill on every call under a lock
+    class MutexTokenBucket {
+    public:
+        MutexTokenBucket(double tokensPerSecond, double burst)
+            : m_Rate(tokensPerSecond), m_Burst(burst), m_Tokens(burst), m_Last(timer::SteadyClockBackend::now()) {}
+
+        bool tryAcquire(std::uint64_t tokens = 1) {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            const timer::TimePoint current = timer::SteadyClockBackend::now();
+            m_Tokens = std::min(m_Burst, m_Tokens + (current - m_Last).count() * m_Rate);
+            m_Last = current;
+            if (m_Tokens < static_cast<double>(tokens)) {
+                return false;
+            }
+            m_Tokens -= static_cast<double>(tokens);
+            return true;
+        }
+
+    private:
+        std::mutex m_Mutex;
+        double m_Rate;
+        double m_Burst;
+        double m_Tokens;
+        timer::TimePoint m_Last;
+    };
+
+    template<typename Limiter>
+    void measure(const std::string &name, unsigned threads, std::size_t callsPerThread, double rate, double burst) {
+        Limiter limiter(rate, burst);
+        std::atomic<std::uint64_t> granted{0};
+        const auto result = timer::time_parallel(threads, [&] {
+            std::uint64_t mine = 0;
+            for (std::size_t i = 0; i < callsPerThread; ++i) {
+                mine += limiter.tryAcquire() ? 1 : 0;
+            }
+            granted.fetch_add(mine, std::memory_order_relaxed);
+        });
+
+        const double calls = static_cast<double>(threads) * static_cast<double>(callsPerThread);
+        const double allowed = rate * result.wallDuration.count() + burst;
+        std::cout << std::setw(22) << name << std::setw(9) << threads
+                  << std::setw(14) << calls / result.wallDuration.count() / 1e6
+                  << std::setw(14) << timer::nanoseconds(result.wallDuration).count() * threads / calls
+                  << std::setw(14) << static_cast<double>(granted.load()) / allowed << '\n';
+    }
+}
+
+int main(int argc, char **argv) {
+    const unsigned maxThreads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 32;
+    const std::size_t callsPerThread = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000;
+    const double rate = 1e6;
+    const double burst = 100.0;
+
+    std::cout << "tryAcquire at " << rate << " tokens/s, burst " << burst << "\n"
+              << std::setw(22) << "limiter" << std::setw(9) << "threads" << std::setw(14) << "Mcalls/s"
+              << std::setw(14) << "ns/call" << std::setw(14) << "granted/limit" << '\n';
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        measure<MutexTokenBucket>("mutex token bucket", threads, callsPerThread, rate, burst);
+        measure<timer::RateLimiter<timer::SteadyClockBackend>>("gcra steady_clock", threads, callsPerThread, rate, burst);
+        measure<timer::RateLimiter<timer::TscClockBackend>>("gcra tsc", threads, callsPerThread, rate, burst);
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Compares how late std::this_thread::sleep_until and timer::sleep_until_precise wake, over random intervals.
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include "timer/sleep.hpp"
+
+int main(int argc, char **argv) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const double maxIntervalUs = argc > 2 ? std::atof(argv[2]) : 2000.0;
+
+    std::mt19937_64 random(11);
+    std::uniform_real_distribution<double> interval(10.0, maxIntervalUs);
+
+    timer::Histogram kernel;
+    for (int i = 0; i < iterations; ++i) {
+        const timer::TimePoint deadline = timer::SteadyClockBackend::now() + timer::microseconds(interval(random));
+        std::this_thread::sleep_until(timer::Clock::time_point(
+            std::chrono::duration_cast<timer::Clock::duration>(deadline.time_since_epoch())));
+        kernel.record(timer::SteadyClockBackend::now() - deadline);
+    }
+
+    timer::Histogram precise;
+    for (int i = 0; i < iterations; ++i) {
+        const timer::TimePoint deadline = timer::SteadyClockBackend::now() + timer::microseconds(interval(random));
+        precise.record(timer::sleep_until_precise(deadline));
+    }
+
+    std::cout << "lateness of std::this_thread::sleep_until:\n";
+    kernel.printSummary(std::cout);
+    std::cout << "lateness of timer::sleep_until_precise:\n";
+    precise.printSummary(std::cout);
+    std::cout << "adapted spin threshold: " << timer::microseconds(timer::thisThreadSleeper().threshold()).count()
+              << " us\n\nsleep_until_precise lateness distribution:\n";
+    precise.printDistribution(std::cout);
+    return 0;
+}
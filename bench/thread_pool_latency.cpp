@@ -0,0 +1,97 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Measures the floor of what the pool can measure: how long a submitted task takes to start on a spinning worker
+// (dispatch latency), and on a parked one (wake-up latency).
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "timer/clocks.hpp"
+#include "timer/stats.hpp"
+#include "timer/thread_pool.hpp"
+
+using Backend = timer::TscClockBackend;
+
+static void report(const char *name, std::vector<timer::Duration> samples) {
+    const timer::SampleStats stats = timer::summarize(samples);
+    std::sort(samples.begin(), samples.end());
+    std::cout << name << ": n=" << stats.count
+              << " min=" << timer::nanoseconds(stats.min).count() << "ns"
+              << " median=" << timer::nanoseconds(stats.median).count() << "ns"
+              << " p99=" << timer::nanoseconds(timer::quantileOfSorted(samples, 0.99)).count() << "ns"
+              << " max=" << timer::nanoseconds(stats.max).count() << "ns\n";
+}
+
+int main(int argc, char **argv) {
+    const int rounds = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const timer::Duration spinBeforePark = timer::milliseconds(1.0);
+
+    // Keep the worker off the submitting thread's core when there is more than one core
+    const std::vector<unsigned> cores = timer::allowedCores();
+    timer::BenchmarkThreadPool pool(1, {cores.back()}, spinBeforePark);
+    if (cores.size() > 1) {
+        timer::pinThisThread(cores.front());
+    }
+
+    std::atomic<std::uint64_t> startedAt{0};
+    auto task = [&] { startedAt.store(Backend::ticks(), std::memory_order_relaxed); };
+    const double ticksPerSecond = Backend::ticksPerSecond();
+
+    std::vector<timer::Duration> dispatch;
+    dispatch.reserve(static_cast<std::size_t>(rounds));
+    for (int i = 0; i < rounds; ++i) {
+        const std::uint64_t submittedAt = Backend::ticks();
+        pool.submit(0, task);
+        pool.wait(0);
+        dispatch.emplace_back(static_cast<double>(startedAt.load() - submittedAt) / ticksPerSecond);
+    }
+
+    const int wakeRounds = std::max(rounds / 100, 10);
+    std::vector<timer::Duration> wake;
+    wake.reserve(static_cast<std::size_t>(wakeRounds));
+    for (int i = 0; i < wakeRounds; ++i) {
+        while (!pool.isParked(0)) {
+            std::this_thread::sleep_for(spinBeforePark);
+        }
+        const std::uint64_t submittedAt = Backend::ticks();
+        pool.submit(0, task);
+        pool.wait(0);
+        wake.emplace_back(static_cast<double>(startedAt.load() - submittedAt) / ticksPerSecond);
+    }
+
+    std::cout << "BenchmarkThreadPool latency (" << Backend::name << " clock, "
+              << (cores.size() > 1 ? "separate cores" : "single core, shared with the submitter") << ")\n";
+    report("dispatch to spinning worker", dispatch);
+    report("wake-up of parked worker  ", wake);
+    return 0;
+}
@@ -0,0 +1,94 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Measures cross-thread scheduling throughput: many producer threads schedule and cancel timers through a TimerQueue
+// while a single owner thread drains the requests into its timing wheel.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "timer/clocks.hpp"
+#include "timer/parallel.hpp"
+#include "timer/timer_queue.hpp"
+
+int main(int argc, char **argv) {
+    const unsigned producers = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 32;
+    const std::size_t timersPerProducer = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+
+    std::cout << "schedule path lock-free: "
+              << (std::atomic<timer::MpscHook *>::is_always_lock_free && std::atomic<double>::is_always_lock_free
+                      ? "yes (no mutex)"
+                      : "no")
+              << '\n';
+
+    timer::TimerQueue queue(timer::milliseconds(1.0));
+    std::vector<timer::QueuedTimer> timers(producers * timersPerProducer);
+    const timer::TimePoint start = timer::SteadyClockBackend::now();
+
+    // The owner drains continuously until the producers are done
+    std::atomic<bool> producing{true};
+    std::size_t applied = 0;
+    std::thread owner([&] {
+        while (producing.load(std::memory_order_acquire)) {
+            applied += queue.drain();
+        }
+        applied += queue.drain();
+    });
+
+    // Each producer schedules its timers one minute out, then cancels every other one
+    const auto result = timer::time_parallel(producers, [&](unsigned producer) {
+        timer::QueuedTimer *mine = timers.data() + producer * timersPerProducer;
+        for (std::size_t i = 0; i < timersPerProducer; ++i) {
+            queue.schedule(mine[i], start + timer::seconds(60.0) + timer::microseconds(static_cast<double>(i)));
+        }
+        for (std::size_t i = 0; i < timersPerProducer; i += 2) {
+            queue.cancel(mine[i]);
+        }
+    });
+    producing.store(false, std::memory_order_release);
+    owner.join();
+
+    const double requests = static_cast<double>(producers) * static_cast<double>(timersPerProducer) * 1.5;
+    timer::Duration slowest{0.0};
+    for (const timer::Duration &duration: result.threadDurations) {
+        slowest = std::max(slowest, duration);
+    }
+
+    std::cout << producers << " producers, " << static_cast<std::size_t>(requests) << " requests\n"
+              << "wall: " << timer::milliseconds(result.wallDuration).count() << " ms\n"
+              << "throughput: " << requests / result.wallDuration.count() / 1e6 << " M requests/s\n"
+              << "slowest producer: " << timer::nanoseconds(slowest).count() / (requests / producers)
+              << " ns/request\n"
+              << "owner applied " << applied << " coalesced requests, " << queue.wheel().size()
+              << " timers scheduled\n";
+    return 0;
+}
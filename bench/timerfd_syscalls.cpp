@@ -0,0 +1,94 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Counts the syscalls an epoll loop makes per expired timer when a TimingWheel is driven by a TimerfdDriver.
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "timer/timerfd_driver.hpp"
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+
+int main(int argc, char **argv) {
+    const std::size_t timerCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    const double spreadMs = argc > 2 ? std::atof(argv[2]) : 500.0;
+
+    timer::TimingWheel wheel(timer::milliseconds(1.0));
+    timer::TimerfdDriver driver(wheel);
+    if (!driver.valid()) {
+        std::cerr << "timerfd_create failed\n";
+        return 1;
+    }
+
+    const int epoll = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    epoll_ctl(epoll, EPOLL_CTL_ADD, driver.fd(), &event);
+
+    // Schedule everything up front, updating the driver after each schedule as an event loop would
+    std::mt19937_64 random(7);
+    std::uniform_real_distribution<double> offset(0.0, spreadMs);
+    std::vector<timer::TimerNode> nodes(timerCount);
+    const timer::TimePoint start = timer::SteadyClockBackend::now();
+    for (timer::TimerNode &node: nodes) {
+        wheel.schedule(node, start + timer::milliseconds(offset(random)));
+        driver.update();
+    }
+
+    std::uint64_t epollWaits = 0;
+    std::size_t expired = 0;
+    while (!wheel.empty()) {
+        epoll_event ready{};
+        ++epollWaits;
+        if (epoll_wait(epoll, &ready, 1, -1) == 1) {
+            expired += driver.onReadable([](timer::TimerNode &) {});
+        }
+    }
+    close(epoll);
+
+    const timer::TimerfdStats &stats = driver.stats();
+    const std::uint64_t syscalls = stats.settimeCalls + stats.readCalls + epollWaits;
+    std::cout << expired << " timers over " << spreadMs << " ms\n"
+              << "timerfd_settime: " << stats.settimeCalls << '\n'
+              << "read:            " << stats.readCalls << '\n'
+              << "epoll_wait:      " << epollWaits << '\n'
+              << "syscalls per expired timer: " << static_cast<double>(syscalls) / static_cast<double>(expired)
+              << '\n';
+    return 0;
+}
+#else
+int main() {
+    std::cout << "timerfd is only available on Linux\n";
+    return 0;
+}
+#endif
@@ -0,0 +1,135 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Compares the hierarchical timing wheel against a binary heap (std::priority_queue) with lazy cancellation.
+// A heap cannot remove an arbitrary element, so the usual workaround of flagging cancelled timers and skipping them
+// on pop is used, which keeps cancelled timers in memory until their deadline.
+
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "timer.hpp"
+#include "timer/timing_wheel.hpp"
+
+struct Connection : timer::TimerNode {
+    std::uint32_t id = 0;
+};
+
+static void report(const char *container, const char *phase, timer::Duration duration, std::size_t operations) {
+    std::cout << container << ' ' << phase << ": " << timer::milliseconds(duration).count() << " ms ("
+              << timer::nanoseconds(duration).count() / static_cast<double>(operations) << " ns/op)\n";
+}
+
+int main(int argc, char **argv) {
+    const std::size_t timerCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const std::uint64_t horizonTicks = 60000; // 60 s of 1 ms ticks
+    const timer::Duration tick = timer::milliseconds(1.0);
+
+    std::mt19937_64 random(42);
+    std::vector<std::uint64_t> deadlines(timerCount);
+    for (std::uint64_t &deadline: deadlines) {
+        deadline = 1 + random() % horizonTicks;
+    }
+    std::vector<std::uint32_t> cancelled;
+    for (std::uint32_t id = 0; id < timerCount; id += 2) {
+        cancelled.push_back(id);
+    }
+
+    const timer::TimePoint origin = timer::SteadyClockBackend::now();
+    auto at = [&](std::uint64_t ticks) { return origin + tick * static_cast<double>(ticks); };
+
+    std::cout << timerCount << " timers over " << horizonTicks << " ticks, half cancelled\n";
+
+    // Timing wheel
+    {
+        timer::TimingWheel wheel(tick, origin);
+        std::vector<Connection> connections(timerCount);
+        for (std::uint32_t id = 0; id < timerCount; ++id) {
+            connections[id].id = id;
+        }
+
+        const auto schedule = timer::time([&] {
+            for (std::uint32_t id = 0; id < timerCount; ++id) {
+                wheel.schedule(connections[id], at(deadlines[id]));
+            }
+        });
+        const auto cancel = timer::time([&] {
+            for (std::uint32_t id: cancelled) {
+                wheel.cancel(connections[id]);
+            }
+        });
+        std::size_t fired = 0;
+        const auto expire = timer::time([&] {
+            for (std::uint64_t now = 1; now <= horizonTicks; ++now) {
+                fired += wheel.advance(at(now), [](timer::TimerNode &) {});
+            }
+        });
+
+        report("wheel", "schedule", schedule.duration, timerCount);
+        report("wheel", "cancel  ", cancel.duration, cancelled.size());
+        report("wheel", "expire  ", expire.duration, fired);
+    }
+
+    // Binary heap with lazy cancellation
+    {
+        using Entry = std::pair<std::uint64_t, std::uint32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<> > heap;
+        std::vector<char> isCancelled(timerCount, 0);
+
+        const auto schedule = timer::time([&] {
+            for (std::uint32_t id = 0; id < timerCount; ++id) {
+                heap.emplace(deadlines[id], id);
+            }
+        });
+        const auto cancel = timer::time([&] {
+            for (std::uint32_t id: cancelled) {
+                isCancelled[id] = 1;
+            }
+        });
+        std::size_t fired = 0;
+        const auto expire = timer::time([&] {
+            for (std::uint64_t now = 1; now <= horizonTicks; ++now) {
+                while (!heap.empty() && heap.top().first <= now) {
+                    fired += isCancelled[heap.top().second] == 0;
+                    heap.pop();
+                }
+            }
+        });
+
+        report("heap ", "schedule", schedule.duration, timerCount);
+        report("heap ", "cancel  ", cancel.duration, cancelled.size());
+        report("heap ", "expire  ", expire.duration, fired);
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#/* ********************************************************************************************************************
+# * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+# * Original Source: https://github.com/Matthew-Krueger/simple-timer
+# *
+# * Redistribution and use in source and binary forms, with or without modification,
+# * are permitted provided that the following conditions are met:
+# *
+# * 1. Redistributions of source code must retain the above copyright notice,
+# * this list of conditions and the following disclaimer.
+# *
+# * 2. Redistributions in binary form must reproduce the above copyright notice,
+# * this list of conditions and the following disclaimer in the documentation
+# * and/or other materials provided with the distribution.
+# *
+# * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+# * or promote products derived from this software without specific prior written permission.
+# *
+# * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+# * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+# * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+# * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+# * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+# *********************************************************************************************************************/
+
+# simple_timer_add_perf_test(<name> SOURCES <sources>... [BASELINE <file>]
+#                            [RELATIVE_THRESHOLD <fraction>] [NOISE_THRESHOLD <deviations>])
+#
+# Builds an executable that uses timer::PerfCheck and registers it as a CTest test labelled "perf".
+# The test fails when a benchmark regresses against the baseline file. A missing baseline file is written by the first
+# run. To re-record it, run the executable with --update-baseline. The baseline defaults to the build directory, so
+# configuring never writes into the source tree. Tests are only registered when enable_testing() has been called.
+# Perf tests run serially, so they do not compete with each other for cores.
+function(simple_timer_add_perf_test name)
+    cmake_parse_arguments(PERF "" "BASELINE;RELATIVE_THRESHOLD;NOISE_THRESHOLD" "SOURCES" ${ARGN})
+    if(NOT PERF_SOURCES)
+        message(FATAL_ERROR "simple_timer_add_perf_test(${name}) needs SOURCES")
+    endif()
+    if(NOT PERF_BASELINE)
+        set(PERF_BASELINE "${CMAKE_CURRENT_BINARY_DIR}/${name}.baseline")
+    endif()
+
+    add_executable(${name} ${PERF_SOURCES})
+    target_link_libraries(${name} PRIVATE simple-timer::simple-timer)
+
+    set(arguments --baseline "${PERF_BASELINE}")
+    if(DEFINED PERF_RELATIVE_THRESHOLD)
+        list(APPEND arguments --relative-threshold ${PERF_RELATIVE_THRESHOLD})
+    endif()
+    if(DEFINED PERF_NOISE_THRESHOLD)
+        list(APPEND arguments --noise-threshold ${PERF_NOISE_THRESHOLD})
+    endif()
+
+    add_test(NAME ${name} COMMAND ${name} ${arguments})
+    set_tests_properties(${name} PROPERTIES LABELS perf RUN_SERIAL TRUE)
+endfunction()
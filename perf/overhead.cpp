@@ -0,0 +1,94 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Checks the overhead of timer::time, the clock backends, Histogram::record and TraceBuffer::emit against a baseline.
+// Registered as the simple-timer-perf CTest test; pass --update-baseline to re-record.
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#include "timer/baseline.hpp"
+#include "timer/clocks.hpp"
+#include "timer/histogram.hpp"
+#include "timer/trace.hpp"
+
+namespace {
+    // Enough calls per iteration that each sample is well above the clock's resolution
+    constexpr std::size_t callsPerIteration = 10000;
+
+    template<typename T>
+    inline void keep(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile char sink;
+        sink = *reinterpret_cast<const volatile char *>(&value);
+#endif
+    }
+}
+
+int main(int argc, char **argv) {
+    timer::PerfCheck check(argc, argv);
+    timer::BenchmarkOptions options;
+    options.iterations = 200;
+    options.itemsPerIteration = callsPerIteration;
+
+    check.measure("time(void)", [] {
+        for (std::size_t i = 0; i < callsPerIteration; ++i) {
+            keep(timer::time([] {}).duration);
+        }
+    }, options);
+    check.measure("steady_clock ticks", [] {
+        for (std::size_t i = 0; i < callsPerIteration; ++i) {
+            keep(timer::SteadyClockBackend::ticks());
+        }
+    }, options);
+    check.measure("tsc ticks", [] {
+        for (std::size_t i = 0; i < callsPerIteration; ++i) {
+            keep(timer::TscClockBackend::ticks());
+        }
+    }, options);
+
+    timer::Histogram histogram;
+    check.measure("Histogram::record", [&] {
+        for (std::size_t i = 0; i < callsPerIteration; ++i) {
+            histogram.record(static_cast<std::uint64_t>(i & 0xffff));
+        }
+    }, options);
+
+    timer::TraceBuffer trace(4096);
+    const timer::TimePoint at = timer::now();
+    check.measure("TraceBuffer::emit", [&] {
+        for (std::size_t i = 0; i < callsPerIteration; ++i) {
+            trace.emit("event", at, at);
+        }
+    }, options);
+
+    return check.finish(std::cout);
+}
@@ -0,0 +1,73 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Checks that fitComplexity picks the right class for synthetic sweeps, including ones with a fixed per-call cost.
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+
+#include "timer/complexity.hpp"
+
+namespace {
+    // The default sweep, 16 to 65536 doubling, timed by an exact cost model in seconds
+    std::vector<timer::ComplexityPoint> sweep(const std::function<double(double)> &seconds) {
+        std::vector<timer::ComplexityPoint> points;
+        for (std::size_t n = 16; n <= (std::size_t{1} << 16); n *= 2) {
+            timer::ComplexityPoint point;
+            point.n = n;
+            point.stats.median = timer::Duration(seconds(static_cast<double>(n)));
+            points.push_back(point);
+        }
+        return points;
+    }
+
+    bool expect(const char *name, const std::function<double(double)> &seconds, timer::Complexity expected) {
+        const std::vector<timer::ComplexityFit> fits = timer::fitComplexity(sweep(seconds));
+        const bool passed = fits.front().complexity == expected;
+        std::cout << (passed ? "ok    " : "FAIL  ") << name << ": " << timer::complexityName(fits.front().complexity)
+                  << ", expected " << timer::complexityName(expected) << '\n';
+        return passed;
+    }
+}
+
+int main() {
+    bool passed = true;
+    passed = expect("1 us", [](double) { return 1e-6; }, timer::Complexity::Constant) && passed;
+    passed = expect("1 ns n", [](double n) { return 1e-9 * n; }, timer::Complexity::Linear) && passed;
+    passed = expect("2 us + 1 ns n", [](double n) { return 2e-6 + 1e-9 * n; }, timer::Complexity::Linear) && passed;
+    passed = expect("5 us + 1 ns n", [](double n) { return 5e-6 + 1e-9 * n; }, timer::Complexity::Linear) && passed;
+    passed = expect("1 us + 1 ps n^2", [](double n) { return 1e-6 + 1e-12 * n * n; }, timer::Complexity::Quadratic)
+             && passed;
+    passed = expect("3 us + 10 ns log n", [](double n) { return 3e-6 + 1e-8 * std::log2(n); },
+                    timer::Complexity::Logarithmic) && passed;
+    passed = expect("1 us + 1 ns n log n", [](double n) { return 1e-6 + 1e-9 * n * std::log2(n); },
+                    timer::Complexity::Linearithmic) && passed;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Checks that RateLimiter admits a full burst after a quiet period, then exactly the configured rate, using a clock
+// the test advances by hand, and that concurrent callers on the real clock never exceed the rate.
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "timer/rate_limiter.hpp"
+
+namespace {
+    // A clock backend that only moves when the test moves it, in nanosecond ticks
+    struct ManualClockBackend {
+        static constexpr const char *name = "manual";
+        static inline std::uint64_t current = 1000000000;
+
+        static inline std::uint64_t ticks() { return current; }
+
+        static inline double ticksPerSecond() { return 1e9; }
+
+        static inline void advance(double seconds) { current += static_cast<std::uint64_t>(seconds * 1e9); }
+    };
+
+    bool check(bool condition, const char *what) {
+        if (!condition) {
+            std::cout << "FAIL  " << what << '\n';
+        }
+        return condition;
+    }
+
+    int admitted(timer::RateLimiter<ManualClockBackend> &limiter, int attempts) {
+        int granted = 0;
+        for (int i = 0; i < attempts; ++i) {
+            granted += limiter.tryAcquire() ? 1 : 0;
+        }
+        return granted;
+    }
+
+    // 1000 tokens per second with a burst of 5: five at once, then one per millisecond
+    bool burstThenSteady() {
+        timer::RateLimiter<ManualClockBackend> limiter(1000.0, 5.0);
+        bool passed = check(limiter.rate() == 1000.0 && limiter.burst() == 5.0, "rate and burst");
+        passed = check(admitted(limiter, 20) == 5, "the initial burst") && passed;
+
+        ManualClockBackend::advance(1e-3);
+        passed = check(admitted(limiter, 20) == 1, "one token after one interval") && passed;
+
+        // Steady state: each interval admits exactly one of several callers
+        int steady = 0;
+        for (int step = 0; step < 1000; ++step) {
+            ManualClockBackend::advance(1e-3);
+            steady += admitted(limiter, 3);
+        }
+        passed = check(steady == 1000, "one token per interval in the steady state") && passed;
+
+        // A long quiet period refills only the burst, not everything that was unused
+        ManualClockBackend::advance(1.0);
+        passed = check(admitted(limiter, 20) == 5, "the burst after a quiet period") && passed;
+
+        // Taking several tokens at once fits the burst, and more than the burst never succeeds
+        ManualClockBackend::advance(1.0);
+        passed = check(!limiter.tryAcquire(6), "more tokens than the burst") && passed;
+        passed = check(limiter.tryAcquire(5), "the whole burst at once") && passed;
+        passed = check(!limiter.tryAcquire(), "a token after the whole burst") && passed;
+
+        // acquire reserves past the burst and waits for the difference
+        const timer::Duration wait = limiter.acquire();
+        passed = check(wait > timer::microseconds(999.0) && wait < timer::microseconds(1001.0),
+                       "acquire waits one interval") && passed;
+        return passed;
+    }
+
+    // Threads hammering one limiter on the real clock never get more than the burst plus the rate over the run
+    bool concurrentUpperBound() {
+        constexpr double rate = 20000.0;
+        constexpr double burst = 10.0;
+        timer::RateLimiter<timer::SteadyClockBackend> limiter(rate, burst);
+        std::atomic<std::uint64_t> granted{0};
+        const timer::TimePoint start = timer::SteadyClockBackend::now();
+        const timer::TimePoint end = start + timer::milliseconds(100.0);
+
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < 4; ++thread) {
+            threads.emplace_back([&] {
+                while (timer::SteadyClockBackend::now() < end) {
+                    if (limiter.tryAcquire()) {
+                        granted.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (std::thread &thread: threads) {
+            thread.join();
+        }
+
+        const double elapsed = (timer::SteadyClockBackend::now() - start).count();
+        return check(static_cast<double>(granted.load()) <= burst + rate * elapsed + 1.0, "more tokens than the rate");
+    }
+}
+
+int main() {
+    bool passed = true;
+    for (const auto &[name, test]: {std::pair{"burst then steady state", &burstThenSteady},
+                                    std::pair{"concurrent upper bound", &concurrentUpperBound}}) {
+        const bool ok = test();
+        std::cout << (ok ? "ok    " : "FAIL  ") << name << '\n';
+        passed = passed && ok;
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Checks that MpscQueue keeps each producer's order and loses nothing while producers and the consumer run at once,
+// and that TimerQueue applies only the latest request for each timer when it drains.
+
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "timer/timer_queue.hpp"
+
+namespace {
+    constexpr unsigned producers = 4;
+    constexpr std::uint64_t itemsPerProducer = 50000;
+
+    struct Item : timer::MpscHook {
+        unsigned producer = 0;
+        std::uint64_t sequence = 0;
+    };
+
+    struct Timeout : timer::QueuedTimer {
+        int fired = 0;
+    };
+
+    bool check(bool condition, const char *what) {
+        if (!condition) {
+            std::cout << "FAIL  " << what << '\n';
+        }
+        return condition;
+    }
+
+    // The consumer pops while every producer pushes, then drains what is left after they finish
+    bool multiProducerOrder() {
+        std::vector<std::vector<Item> > items;
+        for (unsigned producer = 0; producer < producers; ++producer) {
+            items.emplace_back(itemsPerProducer);
+        }
+        timer::MpscQueue queue;
+        bool passed = check(queue.pop() == nullptr, "pop from an empty queue");
+
+        std::vector<std::uint64_t> nextSequence(producers, 0);
+        std::uint64_t received = 0;
+        auto consume = [&] {
+            while (timer::MpscHook *hook = queue.pop()) {
+                const Item &item = static_cast<const Item &>(*hook);
+                passed = check(item.sequence == nextSequence[item.producer], "a producer's items out of order")
+                         && passed;
+                nextSequence[item.producer] = item.sequence + 1;
+                ++received;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned producer = 0; producer < producers; ++producer) {
+            threads.emplace_back([&, producer] {
+                for (std::uint64_t i = 0; i < itemsPerProducer; ++i) {
+                    Item &item = items[producer][i];
+                    item.producer = producer;
+                    item.sequence = i;
+                    queue.push(item);
+                }
+            });
+        }
+        while (received < producers * itemsPerProducer / 2) {
+            consume();
+            std::this_thread::yield();
+        }
+        for (std::thread &thread: threads) {
+            thread.join();
+        }
+        consume();
+
+        passed = check(received == producers * itemsPerProducer, "items lost or duplicated") && passed;
+        passed = check(queue.pop() == nullptr, "queue not empty after draining") && passed;
+        return passed;
+    }
+
+    // Producers on several threads schedule their own timers. Everything must be in the wheel after one drain.
+    bool drainAppliesRequests() {
+        const timer::TimePoint origin{};
+        timer::TimerQueue queue(timer::milliseconds(1.0), origin);
+        std::vector<std::vector<Timeout> > timeouts;
+        for (unsigned producer = 0; producer < producers; ++producer) {
+            timeouts.emplace_back(1000);
+        }
+
+        std::vector<std::thread> threads;
+        for (unsigned producer = 0; producer < producers; ++producer) {
+            threads.emplace_back([&, producer] {
+                for (std::size_t i = 0; i < timeouts[producer].size(); ++i) {
+                    queue.schedule(timeouts[producer][i], origin + timer::milliseconds(1.0 + static_cast<double>(i)));
+                }
+            });
+        }
+        for (std::thread &thread: threads) {
+            thread.join();
+        }
+
+        bool passed = check(queue.drain() == producers * 1000, "drain applied the wrong number of requests");
+        passed = check(queue.wheel().size() == producers * 1000, "wheel size after draining") && passed;
+
+        // Only the latest request counts: scheduled then cancelled stays cancelled, and the reverse fires
+        Timeout cancelled;
+        Timeout rescheduled;
+        queue.schedule(cancelled, origin + timer::milliseconds(10.0));
+        queue.cancel(cancelled);
+        queue.cancel(rescheduled);
+        queue.schedule(rescheduled, origin + timer::milliseconds(10.0));
+        passed = check(cancelled.isRequestPending() && rescheduled.isRequestPending(), "requests not pending") && passed;
+        passed = check(queue.drain() == 2, "repeated requests were queued more than once") && passed;
+        passed = check(!cancelled.isRequestPending(), "request still pending after draining") && passed;
+
+        queue.advance(origin + timer::milliseconds(2000.0),
+                      [](timer::TimerNode &node) { ++static_cast<Timeout &>(node).fired; });
+        for (const std::vector<Timeout> &producerTimeouts: timeouts) {
+            for (const Timeout &timeout: producerTimeouts) {
+                passed = check(timeout.fired == 1, "a scheduled timer did not fire once") && passed;
+            }
+        }
+        passed = check(cancelled.fired == 0, "the latest request was a cancel, but the timer fired") && passed;
+        passed = check(rescheduled.fired == 1, "the latest request was a schedule, but the timer did not fire") && passed;
+        return passed;
+    }
+}
+
+int main() {
+    bool passed = true;
+    for (const auto &[name, test]: {std::pair{"multi-producer order", &multiProducerOrder},
+                                    std::pair{"drain applies the latest requests", &drainAppliesRequests}}) {
+        const bool ok = test();
+        std::cout << (ok ? "ok    " : "FAIL  ") << name << '\n';
+        passed = passed && ok;
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Checks that TimingWheel expires every timer on the tick it is due, across cascades between levels, that cancelled
+// timers never fire, and that nextExpiry never reports a time after the earliest deadline.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "timer/timing_wheel.hpp"
+
+namespace {
+    constexpr double tickSeconds = 1e-3;
+
+    struct Timeout : timer::TimerNode {
+        std::uint64_t dueTick = 0;
+        bool cancelled = false;
+        int fired = 0;
+    };
+
+    timer::TimePoint timeOfTick(double tick) {
+        return timer::TimePoint(timer::Duration(tick * tickSeconds));
+    }
+
+    // Reports the first few failures only, since one bug tends to fail every timer after it
+    bool check(bool condition, const char *what) {
+        static int reported = 0;
+        if (!condition && reported++ < 10) {
+            std::cout << "FAIL  " << what << '\n';
+        }
+        return condition;
+    }
+
+    // Deadlines on both sides of every level boundary, and a pseudo-random spread up to level 2
+    std::vector<double> deadlineTicks() {
+        std::vector<double> ticks;
+        for (const std::uint64_t boundary: {std::uint64_t{1} << 8, std::uint64_t{1} << 16, std::uint64_t{1} << 24}) {
+            for (const std::uint64_t tick: {boundary - 1, boundary, boundary + 1}) {
+                ticks.push_back(static_cast<double>(tick));
+            }
+        }
+        std::uint64_t state = 12345;
+        for (int i = 0; i < 2000; ++i) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            // A fraction of a tick, so most deadlines round up
+            ticks.push_back(static_cast<double>((state >> 33) % (std::uint64_t{1} << 20)) + 1.0 + (i % 4) * 0.25);
+        }
+        return ticks;
+    }
+
+    // Advances in uneven steps, checking each timer fires exactly in the step covering its due tick, in order
+    bool cascadeAndCancel() {
+        timer::TimingWheel wheel(timer::Duration(tickSeconds), timeOfTick(0.0));
+        const std::vector<double> ticks = deadlineTicks();
+        std::vector<Timeout> timeouts(ticks.size());
+        for (std::size_t i = 0; i < ticks.size(); ++i) {
+            timeouts[i].dueTick = static_cast<std::uint64_t>(std::ceil(ticks[i]));
+            wheel.schedule(timeouts[i], timeOfTick(ticks[i]));
+        }
+
+        // Cancel every third timer up front
+        std::size_t expected = ticks.size();
+        for (std::size_t i = 0; i < timeouts.size(); i += 3) {
+            wheel.cancel(timeouts[i]);
+            timeouts[i].cancelled = true;
+            --expected;
+        }
+
+        bool passed = check(wheel.size() == expected, "size after cancelling");
+        std::uint64_t reached = 0;
+        const std::uint64_t end = (std::uint64_t{1} << 24) + 2;
+        std::uint64_t step = 1;
+        while (reached < end) {
+            const std::uint64_t target = std::min(reached + step, end);
+            std::uint64_t lastDue = 0;
+            wheel.advance(timeOfTick(static_cast<double>(target)), [&](timer::TimerNode &node) {
+                Timeout &timeout = static_cast<Timeout &>(node);
+                ++timeout.fired;
+                passed = check(!timeout.cancelled, "a cancelled timer fired") && passed;
+                passed = check(timeout.dueTick > reached && timeout.dueTick <= target, "fired outside its step") && passed;
+                passed = check(timeout.dueTick >= lastDue, "fired out of order") && passed;
+                lastDue = timeout.dueTick;
+
+                // Cancelling a later timer from inside a callback must also stop it
+                Timeout &later = timeouts[(&timeout - timeouts.data() + 1) % timeouts.size()];
+                if (later.isScheduled() && later.dueTick > timeout.dueTick + 1000) {
+                    wheel.cancel(later);
+                    later.cancelled = true;
+                }
+            });
+            reached = target;
+            step = step * 3 + 7;
+        }
+
+        for (const Timeout &timeout: timeouts) {
+            passed = check(timeout.fired == (timeout.cancelled ? 0 : 1), "a timer did not fire exactly once") && passed;
+        }
+        passed = check(wheel.empty(), "wheel empty at the end") && passed;
+        return passed;
+    }
+
+    // Repeatedly advancing to nextExpiry must never skip past a deadline, and must reach every timer
+    bool nextExpiryBound() {
+        timer::TimingWheel wheel(timer::Duration(tickSeconds), timeOfTick(0.0));
+        const std::vector<double> ticks = deadlineTicks();
+        std::vector<Timeout> timeouts(ticks.size());
+        for (std::size_t i = 0; i < ticks.size(); ++i) {
+            timeouts[i].dueTick = static_cast<std::uint64_t>(std::ceil(ticks[i]));
+            wheel.schedule(timeouts[i], timeOfTick(ticks[i]));
+        }
+
+        bool passed = true;
+        std::size_t rounds = 0;
+        while (!wheel.empty() && rounds < 100000) {
+            ++rounds;
+            std::uint64_t earliest = ~std::uint64_t{0};
+            for (const Timeout &timeout: timeouts) {
+                if (timeout.isScheduled()) {
+                    earliest = std::min(earliest, timeout.dueTick);
+                }
+            }
+
+            const std::optional<timer::TimePoint> next = wheel.nextExpiry();
+            if (!check(next.has_value(), "nextExpiry empty with timers scheduled")) {
+                return false;
+            }
+            passed = check(*next <= timeOfTick(static_cast<double>(earliest)), "nextExpiry after the earliest deadline")
+                     && passed;
+            passed = check(*next > wheel.currentTime(), "nextExpiry not in the future") && passed;
+            wheel.advance(*next, [&](timer::TimerNode &node) { ++static_cast<Timeout &>(node).fired; });
+        }
+
+        passed = check(wheel.empty(), "nextExpiry did not reach every timer") && passed;
+        for (const Timeout &timeout: timeouts) {
+            passed = check(timeout.fired == 1, "a timer did not fire exactly once") && passed;
+        }
+        return passed;
+    }
+}
+
+int main() {
+    bool passed = true;
+    for (const auto &[name, test]: {std::pair{"cascade and cancel", &cascadeAndCancel},
+                                    std::pair{"nextExpiry lower bound", &nextExpiryBound}}) {
+        const bool ok = test();
+        std::cout << (ok ? "ok    " : "FAIL  ") << name << '\n';
+        passed = passed && ok;
+    }
+    return passed ? 0 : 1;
+}
@@ -30,9 +30,12 @@
 #pragma once
 #ifndef MCKRUEG_TIMER_HPP
 #define MCKRUEG_TIMER_HPP
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <type_traits>
+#include <utility>
 
 #undef BUILD_WITH_MPI_FLAG
 #ifdef BUILD_WITH_MPI
@@ -57,6 +60,10 @@ extern "C" {
 __attribute__((weak))
 #endif
 double MPI_Wtime();
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((weak))
+#endif
+double MPI_Wtick();
 }
 #endif
 
@@ -93,6 +100,52 @@ namespace timer {
     using TimePoint = std::chrono::time_point<Clock, Duration>;
 
 
+    /**
+     * @brief Reads the measurement clock.
+     * This is MPI_Wtime when building with MPI, and Clock otherwise. Every timer in the library uses it.
+     * @return The current time point.
+     */
+    inline TimePoint now() {
+        if constexpr (BUILD_WITH_MPI_FLAG) {
+            return TimePoint(Duration(MPI_Wtime()));
+        } else {
+            return std::chrono::time_point_cast<Duration>(Clock::now());
+        }
+    }
+
+    /**
+     * @brief The resolution of the measurement clock.
+     * This is MPI_Wtick when building with MPI. Otherwise, it is the smallest nonzero step observed between consecutive
+     * reads of Clock, which is never finer than Clock's period. It is measured once and cached.
+     * See timer/clocks.hpp for a full description of every clock backend.
+     * @return The clock resolution.
+     */
+    inline Duration clockResolution() {
+        static const Duration resolution = [] {
+            if constexpr (BUILD_WITH_MPI_FLAG) {
+                return Duration(MPI_Wtick());
+            } else {
+                auto smallest = Clock::duration::max();
+                for (int i = 0; i < 1000; ++i) {
+                    const auto first = Clock::now();
+                    auto second = Clock::now();
+                    while (second == first) {
+                        second = Clock::now();
+                    }
+                    smallest = std::min(smallest, second - first);
+                }
+                return std::chrono::duration_cast<Duration>(std::max(smallest, Clock::duration(1)));
+            }
+        }();
+        return resolution;
+    }
+
+    /**
+     * The default number of clock ticks below which a measurement is flagged as near the clock resolution.
+     * At ten ticks, the quantization error of a single measurement can still be as large as ten percent.
+     */
+    inline constexpr double defaultResolutionTicks = 10.0;
+
     // Trait: Is the type a std::chrono::duration?
     template<typename T>
     struct is_chrono_duration : std::false_type {
@@ -136,7 +189,7 @@ namespace timer {
             } else if constexpr (std::is_floating_point_v<Rep> || std::is_integral_v<Rep>) {
                 return static_cast<Rep>(duration.count());
             } else {
-                static_assert(false, "Invalid type for as() function");
+                static_assert(!sizeof(Rep), "Invalid type for as() function");
                 return {};
             }
         }
@@ -171,6 +224,16 @@ namespace timer {
          */
         Duration duration;
 
+        /**
+         * The number of bytes the measured call processed, if attached with withBytes. Zero otherwise.
+         */
+        std::uint64_t bytesProcessed = 0;
+
+        /**
+         * The number of items the measured call processed, if attached with withItems. Zero otherwise.
+         */
+        std::uint64_t itemsProcessed = 0;
+
         /**
          * @brief Casts the duration to a specified type.
          * Default: double precision seconds
@@ -210,6 +273,59 @@ namespace timer {
         inline auto getDurationView() const -> TimeView<ReturnDuration> {
             return TimeView<ReturnDuration>{getDuration<ReturnDuration>()};
         }
+
+        /**
+         * @brief Flags a measurement too short to be trusted.
+         * A duration within a few ticks of the clock resolution is dominated by quantization, and is noise rather than
+         * signal. Time a batch of repetitions instead, and divide.
+         * @param ticks The number of clock ticks (see clockResolution) below which the measurement is flagged.
+         * @return True if the duration is shorter than ticks times the clock resolution.
+         */
+        inline bool isNearResolution(double ticks = defaultResolutionTicks) const {
+            return duration.count() < ticks * clockResolution().count();
+        }
+
+        /**
+         * @brief Attaches the number of bytes the measured call processed, for bytesPerSecond.
+         * @example auto result = timer::time(copyBuffer).withBytes(buffer.size());
+         */
+        inline TimeResult &withBytes(std::uint64_t bytes) & {
+            bytesProcessed = bytes;
+            return *this;
+        }
+
+        inline TimeResult &&withBytes(std::uint64_t bytes) && {
+            bytesProcessed = bytes;
+            return std::move(*this);
+        }
+
+        /**
+         * @brief Attaches the number of items the measured call processed, for itemsPerSecond.
+         */
+        inline TimeResult &withItems(std::uint64_t items) & {
+            itemsProcessed = items;
+            return *this;
+        }
+
+        inline TimeResult &&withItems(std::uint64_t items) && {
+            itemsProcessed = items;
+            return std::move(*this);
+        }
+
+        /**
+         * @return The attached byte count divided by the duration, or zero if either is zero. See
+         * timer/throughput.hpp for formatting with decimal or binary prefixes.
+         */
+        inline double bytesPerSecond() const {
+            return duration.count() > 0.0 ? static_cast<double>(bytesProcessed) / duration.count() : 0.0;
+        }
+
+        /**
+         * @return The attached item count divided by the duration, or zero if either is zero.
+         */
+        inline double itemsPerSecond() const {
+            return duration.count() > 0.0 ? static_cast<double>(itemsProcessed) / duration.count() : 0.0;
+        }
     };
 
     /**
@@ -220,6 +336,16 @@ namespace timer {
     struct TimeResult<void> {
         Duration duration;
 
+        /**
+         * The number of bytes the measured call processed, if attached with withBytes. Zero otherwise.
+         */
+        std::uint64_t bytesProcessed = 0;
+
+        /**
+         * The number of items the measured call processed, if attached with withItems. Zero otherwise.
+         */
+        std::uint64_t itemsProcessed = 0;
+
         /**
          * @brief Casts the duration to a specified type.
          * Default: double precision seconds
@@ -259,6 +385,59 @@ namespace timer {
         inline auto getDurationView() const -> TimeView<ReturnDuration> {
             return TimeView<ReturnDuration>{getDuration<ReturnDuration>()};
         }
+
+        /**
+         * @brief Flags a measurement too short to be trusted.
+         * A duration within a few ticks of the clock resolution is dominated by quantization, and is noise rather than
+         * signal. Time a batch of repetitions instead, and divide.
+         * @param ticks The number of clock ticks (see clockResolution) below which the measurement is flagged.
+         * @return True if the duration is shorter than ticks times the clock resolution.
+         */
+        inline bool isNearResolution(double ticks = defaultResolutionTicks) const {
+            return duration.count() < ticks * clockResolution().count();
+        }
+
+        /**
+         * @brief Attaches the number of bytes the measured call processed, for bytesPerSecond.
+         * @example auto result = timer::time(copyBuffer).withBytes(buffer.size());
+         */
+        inline TimeResult &withBytes(std::uint64_t bytes) & {
+            bytesProcessed = bytes;
+            return *this;
+        }
+
+        inline TimeResult &&withBytes(std::uint64_t bytes) && {
+            bytesProcessed = bytes;
+            return std::move(*this);
+        }
+
+        /**
+         * @brief Attaches the number of items the measured call processed, for itemsPerSecond.
+         */
+        inline TimeResult &withItems(std::uint64_t items) & {
+            itemsProcessed = items;
+            return *this;
+        }
+
+        inline TimeResult &&withItems(std::uint64_t items) && {
+            itemsProcessed = items;
+            return std::move(*this);
+        }
+
+        /**
+         * @return The attached byte count divided by the duration, or zero if either is zero. See
+         * timer/throughput.hpp for formatting with decimal or binary prefixes.
+         */
+        inline double bytesPerSecond() const {
+            return duration.count() > 0.0 ? static_cast<double>(bytesProcessed) / duration.count() : 0.0;
+        }
+
+        /**
+         * @return The attached item count divided by the duration, or zero if either is zero.
+         */
+        inline double itemsPerSecond() const {
+            return duration.count() > 0.0 ? static_cast<double>(itemsProcessed) / duration.count() : 0.0;
+        }
     };
 
     // Deduction guide for non-void TimeResult
@@ -339,13 +518,7 @@ namespace timer {
     public:
         ~Timer() {
             // get our end time
-            TimePoint endTimePoint;
-
-            if constexpr (BUILD_WITH_MPI_FLAG) {
-                endTimePoint = TimePoint(Duration(MPI_Wtime()));
-            } else {
-                endTimePoint = std::chrono::time_point_cast<Duration>(Clock::now());
-            }
+            TimePoint endTimePoint = now();
 
             *m_TimeReference = endTimePoint - m_StartTimePoint;
         }
@@ -357,11 +530,7 @@ namespace timer {
          * @param duration A pointer in which to write the resultant time. If it goes out of scope, nothing will be written
          */
         inline explicit Timer(Duration *duration) : m_TimeReference(duration) {
-            if constexpr (BUILD_WITH_MPI_FLAG) {
-                m_StartTimePoint = TimePoint(Duration(MPI_Wtime()));
-            } else {
-                m_StartTimePoint = std::chrono::time_point_cast<Duration>(Clock::now());
-            }
+            m_StartTimePoint = now();
         }
 
         /**
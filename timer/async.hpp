@@ -0,0 +1,178 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_ASYNC_HPP
+#define MCKRUEG_TIMER_ASYNC_HPP
+#include "../timer.hpp"
+#include "platform.hpp"
+
+#include <atomic>
+#include <future>
+#include <type_traits>
+#include <utility>
+
+namespace timer {
+
+    /**
+     * The result of timing an asynchronous operation.
+     * TimeResult<T>::duration holds the submit-to-ready latency: from the start of the submit call until the result
+     * became available. It is always submitDuration + waitDuration.
+     *
+     * @tparam T Type of the asynchronous result.
+     */
+    template<typename T>
+    struct AsyncTimeResult : TimeResult<T> {
+        /**
+         * The time spent in the submit call itself.
+         */
+        Duration submitDuration;
+
+        /**
+         * The time from the submit call returning until the result was ready.
+         */
+        Duration waitDuration;
+    };
+
+    // Trait: Is the type a std::future or std::shared_future?
+    template<typename T>
+    struct is_future : std::false_type {
+    };
+
+    template<typename T>
+    struct is_future<std::future<T> > : std::true_type {
+    };
+
+    template<typename T>
+    struct is_future<std::shared_future<T> > : std::true_type {
+    };
+
+    /**
+     * The SFINAE Return type of time_async: the result type of the future the submit function returns.
+     */
+    template<typename SubmitFunc>
+    using AsyncFutureTimeResult = std::enable_if_t<is_future<std::decay_t<std::invoke_result_t<SubmitFunc> > >::value,
+        AsyncTimeResult<std::decay_t<decltype(std::declval<std::invoke_result_t<SubmitFunc> &>().get())> > >;
+
+    /**
+     * @brief Times an asynchronous operation that returns a std::future or std::shared_future.
+     *
+     * Calls submit, then waits on the calling thread for the future. No thread is created.
+     * The ready timestamp is taken when the wait returns, so it includes the time to wake the calling thread.
+     * The result of the future is stored in functionResult unless it is void. An exception stored in the future is
+     * rethrown.
+     *
+     * @tparam SubmitFunc A callable taking no arguments and returning a std::future<T> or std::shared_future<T>.
+     * @param submit The function that starts the operation.
+     * @return The submit-to-ready latency, split into time to submit and time waiting, and the result.
+     */
+    template<typename SubmitFunc>
+    inline AsyncFutureTimeResult<SubmitFunc> time_async(SubmitFunc submit) {
+        using FutureType = std::decay_t<std::invoke_result_t<SubmitFunc> >;
+        using ResultType = std::decay_t<decltype(std::declval<FutureType &>().get())>;
+
+        const TimePoint start = now();
+        FutureType future = submit();
+        const TimePoint submitted = now();
+        future.wait();
+        const TimePoint ready = now();
+
+        if constexpr (std::is_void_v<ResultType>) {
+            future.get();
+            AsyncTimeResult<void> result{};
+            result.duration = ready - start;
+            result.submitDuration = submitted - start;
+            result.waitDuration = ready - submitted;
+            return result;
+        } else {
+            return AsyncTimeResult<ResultType>{
+                {future.get(), ready - start},
+                submitted - start,
+                ready - submitted
+            };
+        }
+    }
+
+    /**
+     * The completion handle passed to the submit function of time_async_callback.
+     * Call it exactly once, from any thread, when the operation completes. It is cheap to copy.
+     */
+    class AsyncCompletion {
+    public:
+        inline void operator()() const {
+            m_State->ready = now();
+            m_State->done.store(true, std::memory_order_release);
+        }
+
+    private:
+        struct State {
+            std::atomic<bool> done{false};
+            TimePoint ready;
+        };
+
+        inline explicit AsyncCompletion(State *state) : m_State(state) {}
+
+        State *m_State;
+
+        template<typename SubmitFunc>
+        friend AsyncTimeResult<void> time_async_callback(SubmitFunc);
+    };
+
+    /**
+     * @brief Times an asynchronous operation that signals completion through a callback.
+     *
+     * Calls submit with an AsyncCompletion, then waits on the calling thread until it is called. No thread is created.
+     * The ready timestamp is taken inside the completion call itself, so it excludes the time to wake the caller.
+     * The caller spins briefly and then yields while waiting.
+     *
+     * @tparam SubmitFunc A callable taking an AsyncCompletion, which the operation must call exactly once.
+     * @param submit The function that starts the operation.
+     * @return The submit-to-ready latency, split into time to submit and time waiting.
+     */
+    template<typename SubmitFunc>
+    inline AsyncTimeResult<void> time_async_callback(SubmitFunc submit) {
+        AsyncCompletion::State state;
+
+        const TimePoint start = now();
+        submit(AsyncCompletion(&state));
+        const TimePoint submitted = now();
+        spinUntil([&] { return state.done.load(std::memory_order_acquire); });
+
+        // A completion called inline, before submit returned, leaves nothing to wait for
+        const TimePoint ready = state.ready < submitted ? submitted : state.ready;
+
+        AsyncTimeResult<void> result{};
+        result.duration = ready - start;
+        result.submitDuration = submitted - start;
+        result.waitDuration = ready - submitted;
+        return result;
+    }
+}
+
+#endif //MCKRUEG_TIMER_ASYNC_HPP
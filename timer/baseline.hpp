@@ -0,0 +1,352 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_BASELINE_HPP
+#define MCKRUEG_TIMER_BASELINE_HPP
+#include "../timer.hpp"
+#include "benchmark.hpp"
+#include "environment.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * What makes timings from two machines, or two builds, incomparable.
+     */
+    struct HostFingerprint {
+        std::string cpuModel;
+
+        /**
+         * The cpufreq governor of the benchmark core, or empty if the platform does not report one.
+         */
+        std::string governor;
+        std::string compiler;
+
+        inline bool operator==(const HostFingerprint &other) const {
+            return cpuModel == other.cpuModel && governor == other.governor && compiler == other.compiler;
+        }
+
+        inline bool operator!=(const HostFingerprint &other) const { return !(*this == other); }
+    };
+
+    /**
+     * @return The CPU model, frequency governor and compiler from currentEnvironment.
+     */
+    inline HostFingerprint hostFingerprint() {
+        const Environment &environment = currentEnvironment();
+        return HostFingerprint{environment.cpuModel, environment.governor, environment.compiler};
+    }
+
+    /**
+     * The stored summary of one benchmark.
+     */
+    struct BaselineEntry {
+        std::string name;
+        Duration median{0.0};
+        Duration mad{0.0};
+        std::size_t count = 0;
+    };
+
+    /**
+     * A set of benchmark summaries and the host they were measured on.
+     */
+    struct Baseline {
+        HostFingerprint host;
+        std::vector<BaselineEntry> entries;
+
+        /**
+         * @return The entry with the given name, or nullptr.
+         */
+        inline const BaselineEntry *find(const std::string &name) const {
+            const auto found = std::find_if(entries.begin(), entries.end(),
+                                            [&](const BaselineEntry &entry) { return entry.name == name; });
+            return found == entries.end() ? nullptr : &*found;
+        }
+    };
+
+    inline constexpr const char *baselineFileHeader = "# simple-timer baseline v1";
+
+    /**
+     * @brief Writes a baseline as tab separated text: the host fields, then one line per benchmark with its median
+     * and MAD in seconds and its sample count.
+     * @return True if the file was written.
+     */
+    inline bool writeBaseline(const std::string &path, const Baseline &baseline) {
+        std::ofstream out(path);
+        out << baselineFileHeader << '\n'
+            << "cpu\t" << baseline.host.cpuModel << '\n'
+            << "governor\t" << baseline.host.governor << '\n'
+            << "compiler\t" << baseline.host.compiler << '\n'
+            << std::setprecision(17);
+        for (const BaselineEntry &entry: baseline.entries) {
+            out << "benchmark\t" << entry.name << '\t' << entry.median.count() << '\t' << entry.mad.count() << '\t'
+                << entry.count << '\n';
+        }
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * @return The baseline in the file, or nothing if it is missing or not a baseline file.
+     */
+    inline std::optional<Baseline> readBaseline(const std::string &path) {
+        std::ifstream in(path);
+        std::string line;
+        if (!std::getline(in, line) || line != baselineFileHeader) {
+            return std::nullopt;
+        }
+
+        Baseline baseline;
+        while (std::getline(in, line)) {
+            std::vector<std::string> fields;
+            std::stringstream stream(line);
+            for (std::string field; std::getline(stream, field, '\t');) {
+                fields.push_back(field);
+            }
+            if (fields.size() == 2 && fields[0] == "cpu") {
+                baseline.host.cpuModel = fields[1];
+            } else if (fields.size() == 2 && fields[0] == "governor") {
+                baseline.host.governor = fields[1];
+            } else if (fields.size() == 2 && fields[0] == "compiler") {
+                baseline.host.compiler = fields[1];
+            } else if (fields.size() == 5 && fields[0] == "benchmark") {
+                baseline.entries.push_back(BaselineEntry{fields[1], Duration(std::atof(fields[2].c_str())),
+                                                         Duration(std::atof(fields[3].c_str())),
+                                                         static_cast<std::size_t>(std::atoll(fields[4].c_str()))});
+            }
+        }
+        return baseline;
+    }
+
+    /**
+     * How much slower a benchmark must get before it counts as a regression.
+     * A change counts only if it exceeds both thresholds: the relative one ignores changes too small to matter, and
+     * the noise one ignores changes the uncertainty of the two medians could explain.
+     */
+    struct RegressionThresholds {
+        /**
+         * The smallest change that matters, as a fraction of the baseline median.
+         */
+        double relative = 0.05;
+
+        /**
+         * The change must also exceed this many combined standard errors of the two medians.
+         */
+        double noise = 3.0;
+    };
+
+    enum class RegressionStatus {
+        Unchanged,
+        Regressed,
+        Improved,
+
+        /**
+         * The benchmark is not in the baseline.
+         */
+        New
+    };
+
+    inline const char *regressionStatusName(RegressionStatus status) {
+        switch (status) {
+            case RegressionStatus::Regressed:
+                return "REGRESSED";
+            case RegressionStatus::Improved:
+                return "improved";
+            case RegressionStatus::New:
+                return "new";
+            default:
+                return "ok";
+        }
+    }
+
+    namespace detail {
+        /**
+         * The standard error of a median, from the MAD and the sample count. 1.4826 * MAD estimates the standard
+         * deviation, and the median of n normal samples has a standard error of about 1.2533 * sigma / sqrt(n).
+         */
+        inline double medianStandardError(Duration mad, std::size_t count) {
+            return 1.2533 * 1.4826 * mad.count() / std::sqrt(static_cast<double>(std::max<std::size_t>(count, 1)));
+        }
+    }
+
+    /**
+     * @brief Classifies a benchmark's current summary against its baseline entry.
+     * @param baseline The stored entry, or nullptr if there is none.
+     * @param current The current run.
+     * @param thresholds The relative and noise thresholds.
+     */
+    inline RegressionStatus checkRegression(const BaselineEntry *baseline, const SampleStats &current,
+                                            const RegressionThresholds &thresholds = {}) {
+        if (baseline == nullptr) {
+            return RegressionStatus::New;
+        }
+        const double change = current.median.count() - baseline->median.count();
+        const double error = std::hypot(detail::medianStandardError(baseline->mad, baseline->count),
+                                        detail::medianStandardError(current.mad, current.count));
+        const double threshold = std::max(thresholds.relative * baseline->median.count(), thresholds.noise * error);
+        if (change > threshold) {
+            return RegressionStatus::Regressed;
+        }
+        if (-change > threshold) {
+            return RegressionStatus::Improved;
+        }
+        return RegressionStatus::Unchanged;
+    }
+
+    /**
+     * A performance test: checks a set of benchmarks against a baseline file and reports failure as a process exit
+     * code, for use as a CTest test through simple_timer_add_perf_test.
+     *
+     * If the baseline file does not exist, or --update-baseline is given, the current results become the baseline and
+     * the check passes. If the baseline was recorded on a different host, the results are reported but cannot fail.
+     *
+     * Recognized arguments: --baseline <path>, --update-baseline, --relative-threshold <fraction> and
+     * --noise-threshold <deviations>.
+     */
+    class PerfCheck {
+    public:
+        /**
+         * @param argc The argument count from main.
+         * @param argv The arguments from main.
+         * @param defaultPath The baseline file if --baseline is not given.
+         */
+        inline PerfCheck(int argc, char **argv, std::string defaultPath = "perf.baseline")
+            : m_Path(std::move(defaultPath)) {
+            for (int i = 1; i < argc; ++i) {
+                const std::string argument = argv[i];
+                const bool hasValue = i + 1 < argc;
+                if (argument == "--baseline" && hasValue) {
+                    m_Path = argv[++i];
+                } else if (argument == "--update-baseline") {
+                    m_Update = true;
+                } else if (argument == "--relative-threshold" && hasValue) {
+                    m_Thresholds.relative = std::atof(argv[++i]);
+                } else if (argument == "--noise-threshold" && hasValue) {
+                    m_Thresholds.noise = std::atof(argv[++i]);
+                }
+            }
+        }
+
+        /**
+         * @brief Adds a benchmark result to the check.
+         */
+        inline void add(const std::string &name, const BenchmarkResult &result) {
+            m_Current.push_back(BaselineEntry{name, result.stats.median, result.stats.mad, result.stats.count});
+            m_Throughputs.push_back(result.throughput);
+        }
+
+        /**
+         * @brief Benchmarks a callable and adds the result to the check.
+         */
+        template<typename FuncToTime>
+        inline void measure(const std::string &name, FuncToTime &&toTime, const BenchmarkOptions &options = {}) {
+            add(name, benchmark(std::forward<FuncToTime>(toTime), options));
+        }
+
+        /**
+         * @brief Compares every added benchmark with the baseline and prints a report.
+         * @return The exit code: 0 if nothing regressed, 1 if something did, 2 if the baseline could not be written
+         * or benchmarking was refused. A refused run leaves the baseline untouched.
+         */
+        inline int finish(std::ostream &out) const {
+            printEnvironmentHeader(out);
+            if (benchmarkingRefused()) {
+                return 2;
+            }
+            Baseline current{hostFingerprint(), m_Current};
+            const std::optional<Baseline> stored = m_Update ? std::nullopt : readBaseline(m_Path);
+            if (!stored) {
+                if (!writeBaseline(m_Path, current)) {
+                    out << "could not write baseline " << m_Path << '\n';
+                    return 2;
+                }
+                out << "wrote baseline " << m_Path << " with " << current.entries.size() << " benchmarks\n";
+                return 0;
+            }
+
+            const bool sameHost = stored->host == current.host;
+            if (!sameHost) {
+                out << "baseline " << m_Path << " was recorded on a different host, so regressions are not enforced\n"
+                    << "  baseline: " << stored->host.cpuModel << ", " << stored->host.governor << ", "
+                    << stored->host.compiler << '\n'
+                    << "  current:  " << current.host.cpuModel << ", " << current.host.governor << ", "
+                    << current.host.compiler << '\n';
+            }
+
+            // The table switches the stream to fixed precision, so the caller's formatting is restored afterwards
+            const std::ios_base::fmtflags flags = out.flags();
+            const std::streamsize precision = out.precision();
+            bool regressed = false;
+            out << std::left << std::setw(32) << "benchmark" << std::right << std::setw(16) << "baseline (us)"
+                << std::setw(16) << "current (us)" << std::setw(10) << "change" << "  status     throughput\n";
+            for (std::size_t i = 0; i < current.entries.size(); ++i) {
+                const BaselineEntry &entry = current.entries[i];
+                const BaselineEntry *base = stored->find(entry.name);
+                SampleStats stats;
+                stats.median = entry.median;
+                stats.mad = entry.mad;
+                stats.count = entry.count;
+                const RegressionStatus status = checkRegression(base, stats, m_Thresholds);
+                regressed = regressed || status == RegressionStatus::Regressed;
+
+                out << std::left << std::setw(32) << entry.name << std::right << std::fixed << std::setprecision(3)
+                    << std::setw(16) << (base ? microseconds(base->median).count() : 0.0) << std::setw(16)
+                    << microseconds(entry.median).count() << std::setprecision(1) << std::setw(9)
+                    << (base ? (entry.median / base->median - 1.0) * 100.0 : 0.0) << "%  "
+                    << std::left << std::setw(11) << regressionStatusName(status) << std::right
+                    << formatThroughput(m_Throughputs[i]) << '\n';
+            }
+            out.flags(flags);
+            out.precision(precision);
+            return regressed && sameHost ? 1 : 0;
+        }
+
+    private:
+        std::string m_Path;
+        bool m_Update = false;
+        RegressionThresholds m_Thresholds;
+        std::vector<BaselineEntry> m_Current;
+        std::vector<Throughput> m_Throughputs;
+    };
+}
+
+#endif //MCKRUEG_TIMER_BASELINE_HPP
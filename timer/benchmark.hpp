@@ -0,0 +1,107 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_BENCHMARK_HPP
+#define MCKRUEG_TIMER_BENCHMARK_HPP
+#include "../timer.hpp"
+#include "environment.hpp"
+#include "stats.hpp"
+#include "throughput.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * Options for repeated measurement of a callable.
+     */
+    struct BenchmarkOptions {
+        /**
+         * The number of timed runs.
+         */
+        std::size_t iterations = 30;
+
+        /**
+         * The number of untimed runs before the timed ones, to warm caches, branch predictors and lazy initialization.
+         */
+        std::size_t warmupIterations = 3;
+
+        /**
+         * The bytes each run processes. When nonzero, the result reports a byte rate.
+         */
+        std::uint64_t bytesPerIteration = 0;
+
+        /**
+         * The items each run processes. When nonzero, the result reports an item rate.
+         */
+        std::uint64_t itemsPerIteration = 0;
+    };
+
+    /**
+     * The result of a benchmark: every sample, their summary, and the throughput if a byte or item count was given.
+     */
+    struct BenchmarkResult {
+        std::vector<Duration> samples;
+        SampleStats stats;
+        Throughput throughput;
+    };
+
+    /**
+     * @brief Times a callable repeatedly with timer::time.
+     * Any value the callable returns is discarded.
+     * @tparam FuncToTime The type of function to time.
+     * @param toTime The function to time.
+     * @param options The number of warmup and timed runs, and the work each run does.
+     * @return Every sample, their summary statistics and the throughput. Empty if benchmarkingRefused().
+     */
+    template<typename FuncToTime>
+    inline BenchmarkResult benchmark(FuncToTime &&toTime, const BenchmarkOptions &options = {}) {
+        if (benchmarkingRefused()) {
+            return BenchmarkResult{};
+        }
+        for (std::size_t i = 0; i < options.warmupIterations; ++i) {
+            toTime();
+        }
+
+        BenchmarkResult result;
+        result.samples.reserve(options.iterations);
+        for (std::size_t i = 0; i < options.iterations; ++i) {
+            result.samples.push_back(time([&toTime] { return toTime(); }).duration);
+        }
+        result.stats = summarize(result.samples);
+        result.throughput = throughputOf(result.samples, options.bytesPerIteration, options.itemsPerIteration);
+        return result;
+    }
+}
+
+#endif //MCKRUEG_TIMER_BENCHMARK_HPP
@@ -0,0 +1,331 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_CACHE_HPP
+#define MCKRUEG_TIMER_CACHE_HPP
+#include "../timer.hpp"
+#include "benchmark.hpp"
+#include "environment.hpp"
+#include "stats.hpp"
+#include "throughput.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define MCKRUEG_TIMER_HAS_CLFLUSH 1
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#define MCKRUEG_TIMER_HAS_CLFLUSH 1
+#else
+#define MCKRUEG_TIMER_HAS_CLFLUSH 0
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace timer {
+
+    /**
+     * The cache line size assumed when flushing. Flushing every 64 bytes is correct, if redundant, on CPUs with
+     * larger lines.
+     */
+    inline constexpr std::size_t cacheLineSize = 64;
+
+    /**
+     * @return The size of the last level cache in bytes, from sysconf or sysfs, or 32 MiB if neither reports it.
+     */
+    inline std::size_t lastLevelCacheSize() {
+        static const std::size_t size = [] {
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+            const long level3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+            if (level3 > 0) {
+                return static_cast<std::size_t>(level3);
+            }
+#endif
+            // The largest cache index cpu0 reports, with sizes like "32768K"
+            std::size_t largest = 0;
+            for (int index = 0; index < 8; ++index) {
+                std::ifstream in("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/size");
+                std::size_t value = 0;
+                char unit = 0;
+                if (in >> value) {
+                    in >> unit;
+                    largest = std::max(largest, value * (unit == 'K' ? 1024 : unit == 'M' ? 1024 * 1024 : 1));
+                }
+            }
+            return largest > 0 ? largest : std::size_t{32} << 20;
+        }();
+        return size;
+    }
+
+    namespace detail {
+        inline bool hasClflushopt() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+            static const bool supported = [] {
+                unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+                return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0 && (ebx & (1u << 23)) != 0;
+            }();
+            return supported;
+#else
+            return false;
+#endif
+        }
+    }
+
+    /**
+     * @brief Evicts a range of memory from every cache level, and waits until the evictions are complete.
+     * Uses clflushopt where the CPU has it and clflush otherwise on x86, and dc civac on AArch64. Elsewhere it does
+     * nothing and returns false; stream through a scratch buffer instead.
+     * @param data The start of the range.
+     * @param bytes The length of the range.
+     * @return True if the range was flushed.
+     */
+    inline bool flushCacheLines(const void *data, std::size_t bytes) {
+#if MCKRUEG_TIMER_HAS_CLFLUSH
+        const auto start = reinterpret_cast<std::uintptr_t>(data) & ~(cacheLineSize - 1);
+        const auto end = reinterpret_cast<std::uintptr_t>(data) + bytes;
+#if defined(__x86_64__) || defined(__i386__)
+        // clflushopt is only weakly ordered, so the loop pipelines, and the fence waits for all of it
+        if (detail::hasClflushopt()) {
+            for (std::uintptr_t line = start; line < end; line += cacheLineSize) {
+                asm volatile(".byte 0x66; clflush %0" : "+m"(*reinterpret_cast<volatile char *>(line)));
+            }
+        } else {
+            for (std::uintptr_t line = start; line < end; line += cacheLineSize) {
+                _mm_clflush(reinterpret_cast<const void *>(line));
+            }
+        }
+        _mm_mfence();
+#else
+        for (std::uintptr_t line = start; line < end; line += cacheLineSize) {
+            asm volatile("dc civac, %0" ::"r"(line) : "memory");
+        }
+        asm volatile("dsb ish" ::: "memory");
+#endif
+        return true;
+#else
+        (void) data;
+        (void) bytes;
+        return false;
+#endif
+    }
+
+    /**
+     * A buffer larger than the last level cache. Writing and then reading all of it replaces everything the cache
+     * held, including data whose address is unknown, at the cost of touching far more memory than a targeted flush.
+     */
+    class CacheScratch {
+    public:
+        /**
+         * @param bytes The scratch size. Zero means twice the last level cache, to defeat non-LRU replacement.
+         */
+        inline explicit CacheScratch(std::size_t bytes = 0)
+            : m_Lines((bytes > 0 ? bytes : 2 * lastLevelCacheSize()) / sizeof(std::uint64_t), 0) {}
+
+        /**
+         * @brief Streams through the whole buffer.
+         */
+        inline void evict() {
+            std::uint64_t sum = 0;
+            const std::size_t stride = cacheLineSize / sizeof(std::uint64_t);
+            for (std::size_t i = 0; i < m_Lines.size(); i += stride) {
+                m_Lines[i] += 1;
+            }
+            for (std::size_t i = 0; i < m_Lines.size(); i += stride) {
+                sum += m_Lines[i];
+            }
+            m_Sink = sum;
+        }
+
+        inline std::size_t size() const { return m_Lines.size() * sizeof(std::uint64_t); }
+
+    private:
+        std::vector<std::uint64_t> m_Lines;
+        volatile std::uint64_t m_Sink = 0;
+    };
+
+    /**
+     * How a cold run is prepared before each timed call.
+     */
+    enum class ColdCacheMode {
+        /**
+         * Flush the registered buffers with clflushopt. The cheapest, but only covers memory the caller names.
+         */
+        FlushBuffers,
+
+        /**
+         * Stream through a scratch buffer larger than the last level cache.
+         */
+        EvictLastLevel,
+
+        /**
+         * Pass a different one of K input copies to each call, so each copy has been evicted by the others by the
+         * time it is used again. Nothing extra runs between calls.
+         */
+        RotateCopies
+    };
+
+    /**
+     * A range of memory the callable works on, flushed before each cold run in FlushBuffers mode.
+     */
+    struct CacheBuffer {
+        const void *data = nullptr;
+        std::size_t bytes = 0;
+    };
+
+    /**
+     * Options for a cold and warm cache benchmark.
+     */
+    struct CacheBenchmarkOptions {
+        /**
+         * The runs of each mode, and the work per run. Warmup runs only apply to the warm mode.
+         */
+        BenchmarkOptions benchmark;
+        ColdCacheMode coldMode = ColdCacheMode::EvictLastLevel;
+
+        /**
+         * The working set to flush in FlushBuffers mode.
+         */
+        std::vector<CacheBuffer> buffers;
+
+        /**
+         * The scratch size in EvictLastLevel mode. Zero means twice the last level cache.
+         */
+        std::size_t scratchBytes = 0;
+
+        /**
+         * The number of input copies in RotateCopies mode.
+         */
+        std::size_t copies = 8;
+    };
+
+    /**
+     * The cold and warm measurements of the same callable.
+     */
+    struct CacheBenchmarkResult {
+        BenchmarkResult cold;
+        BenchmarkResult warm;
+    };
+
+    namespace detail {
+        template<typename FuncToTime>
+        inline void invokeWithCopy(FuncToTime &toTime, std::size_t copy) {
+            if constexpr (std::is_invocable_v<FuncToTime &, std::size_t>) {
+                toTime(copy);
+            } else {
+                toTime();
+            }
+        }
+    }
+
+    /**
+     * @brief Times a callable with cold caches and with warm caches, and reports both.
+     *
+     * Repeated timing of a memory-bound callable measures it with its working set already cached, which production
+     * rarely sees. For the cold runs, the caches are emptied before every call, outside the timed window. For the warm
+     * runs, the callable is simply called repeatedly.
+     *
+     * The callable may take the index of the input copy as a std::size_t. In RotateCopies mode the cold runs cycle
+     * through copies 0 to copies - 1, and the warm runs always use copy 0. In the other modes the index is always 0.
+     *
+     * @param toTime The callable.
+     * @param options The cold mode, what it needs, and the runs and work per run.
+     * @return The cold and warm samples, statistics and throughput.
+     */
+    template<typename FuncToTime>
+    inline CacheBenchmarkResult cacheBenchmark(FuncToTime &&toTime, const CacheBenchmarkOptions &options = {}) {
+        const BenchmarkOptions &runs = options.benchmark;
+        CacheBenchmarkResult result;
+        if (benchmarkingRefused()) {
+            return result;
+        }
+
+        std::vector<CacheScratch> scratch;
+        if (options.coldMode == ColdCacheMode::EvictLastLevel) {
+            scratch.emplace_back(options.scratchBytes);
+        }
+        const std::size_t copies = std::max<std::size_t>(options.copies, 1);
+
+        result.cold.samples.reserve(runs.iterations);
+        for (std::size_t i = 0; i < runs.iterations; ++i) {
+            std::size_t copy = 0;
+            switch (options.coldMode) {
+                case ColdCacheMode::FlushBuffers:
+                    for (const CacheBuffer &buffer: options.buffers) {
+                        flushCacheLines(buffer.data, buffer.bytes);
+                    }
+                    break;
+                case ColdCacheMode::EvictLastLevel:
+                    scratch.front().evict();
+                    break;
+                case ColdCacheMode::RotateCopies:
+                    copy = i % copies;
+                    break;
+            }
+            result.cold.samples.push_back(time([&] { detail::invokeWithCopy(toTime, copy); }).duration);
+        }
+        result.cold.stats = summarize(result.cold.samples);
+        result.cold.throughput = throughputOf(result.cold.samples, runs.bytesPerIteration, runs.itemsPerIteration);
+
+        result.warm = benchmark([&] { detail::invokeWithCopy(toTime, 0); }, runs);
+        return result;
+    }
+
+    /**
+     * @brief Prints the cold and warm medians, MADs and throughput, and the cold to warm ratio.
+     */
+    inline void printCacheReport(std::ostream &out, const CacheBenchmarkResult &result) {
+        printEnvironmentHeader(out);
+        const auto line = [&](const char *name, const BenchmarkResult &measured) {
+            out << name << ": median " << microseconds(measured.stats.median).count() << " us, MAD "
+                << microseconds(measured.stats.mad).count() << " us";
+            if (!measured.throughput.empty()) {
+                out << ", " << formatThroughput(measured.throughput);
+            }
+            out << '\n';
+        };
+        line("cold", result.cold);
+        line("warm", result.warm);
+        if (result.warm.stats.median.count() > 0.0) {
+            out << "cold / warm: " << result.cold.stats.median / result.warm.stats.median << "x\n";
+        }
+    }
+}
+
+#endif //MCKRUEG_TIMER_CACHE_HPP
@@ -0,0 +1,310 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_CLOCK_CHECK_HPP
+#define MCKRUEG_TIMER_CLOCK_CHECK_HPP
+#include "../timer.hpp"
+#include "clocks.hpp"
+#include "environment.hpp"
+#include "platform.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * Options for a cross-core clock check.
+     */
+    struct ClockCheckOptions {
+        /**
+         * The cores to check, every pair of them. Empty checks every core the process may use. Needs at least two.
+         */
+        std::vector<unsigned> cores;
+
+        /**
+         * The timestamp round trips per pair.
+         */
+        std::size_t rounds = 2000;
+
+        /**
+         * Round trips run before measuring, to settle the cache line and wake both cores.
+         */
+        std::size_t warmupRounds = 50;
+    };
+
+    /**
+     * How the clock on one core compares with the clock on another.
+     *
+     * A timestamp is read on the first core and handed to the second through a shared cache line, which reads its own
+     * clock on receipt and hands that back. Since each read happens after the previous one, a clock that is
+     * consistent across cores never goes backwards along the way. Every round trip also bounds the offset of the
+     * second core's clock: it lies between (second - returned) and (second - sent). The tightest bounds over every
+     * round are kept.
+     */
+    struct ClockPairSkew {
+        unsigned from = 0;
+        unsigned to = 0;
+
+        /**
+         * The estimated offset of the clock on `to` relative to `from`, in nanoseconds. Midway between the bounds.
+         */
+        double offset = 0.0;
+
+        /**
+         * The bounds on the offset, in nanoseconds.
+         */
+        double lowerBound = 0.0;
+        double upperBound = 0.0;
+
+        std::size_t rounds = 0;
+
+        /**
+         * The number of reads that were earlier than a read that happened before them.
+         */
+        std::size_t backwards = 0;
+
+        /**
+         * The largest backward jump, in nanoseconds.
+         */
+        double largestBackwards = 0.0;
+
+        /**
+         * @return True if the clocks never went backwards and the bounds admit a zero offset.
+         */
+        inline bool consistent() const { return backwards == 0 && lowerBound <= 0.0 && upperBound >= 0.0; }
+    };
+
+    /**
+     * The result of checking one clock backend across every pair of cores.
+     */
+    struct ClockCheckResult {
+        std::string backend;
+        std::vector<unsigned> cores;
+
+        /**
+         * One entry per pair of distinct cores, from < to.
+         */
+        std::vector<ClockPairSkew> pairs;
+
+        /**
+         * False if the checking threads could not be pinned, in which case the cores are only nominal.
+         */
+        bool pinned = true;
+
+        /**
+         * @return The pair measured between cores a and b, or nullptr.
+         */
+        inline const ClockPairSkew *find(unsigned a, unsigned b) const {
+            for (const ClockPairSkew &pair: pairs) {
+                if (pair.from == a && pair.to == b) {
+                    return &pair;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @return False if no pair was compared, because fewer than two cores were given, or if the threads could not
+         * be pinned, so the pairs may never have run on separate cores.
+         */
+        inline bool conclusive() const { return pinned && !pairs.empty(); }
+
+        /**
+         * @return True if the check is conclusive and every pair is consistent.
+         */
+        inline bool consistent() const {
+            return conclusive() && std::all_of(pairs.begin(), pairs.end(),
+                                               [](const ClockPairSkew &pair) { return pair.consistent(); });
+        }
+    };
+
+    namespace detail {
+        /**
+         * The shared cache line. The stamp is written before the sequence number is published, and read after it is
+         * observed, so both travel in one line transfer.
+         */
+        struct alignas(64) ClockCheckLine {
+            std::atomic<std::uint64_t> sequence{0};
+            std::atomic<std::uint64_t> stamp{0};
+        };
+
+        template<typename Backend>
+        inline ClockPairSkew checkPair(unsigned from, unsigned to, const ClockCheckOptions &options, bool &pinned) {
+            ClockCheckLine line;
+            const std::size_t total = options.warmupRounds + options.rounds;
+
+            // The responder reports its own pinning, which is only combined after the join
+            bool responderPinned = false;
+            std::thread responder([&] {
+                responderPinned = pinThisThread(to);
+                for (std::uint64_t round = 0; round < total; ++round) {
+                    spinUntil([&] { return line.sequence.load(std::memory_order_acquire) == 2 * round + 1; });
+                    line.stamp.store(Backend::ticks(), std::memory_order_relaxed);
+                    line.sequence.store(2 * round + 2, std::memory_order_release);
+                }
+            });
+
+            ScopedAffinity affinity(std::vector<unsigned>{from});
+
+            const double nanosecondsPerTick = 1e9 / Backend::ticksPerSecond();
+            ClockPairSkew skew;
+            skew.from = from;
+            skew.to = to;
+            skew.rounds = options.rounds;
+            double lower = -std::numeric_limits<double>::infinity();
+            double upper = std::numeric_limits<double>::infinity();
+
+            for (std::uint64_t round = 0; round < total; ++round) {
+                const std::uint64_t sent = Backend::ticks();
+                line.sequence.store(2 * round + 1, std::memory_order_release);
+                spinUntil([&] { return line.sequence.load(std::memory_order_acquire) == 2 * round + 2; });
+                const std::uint64_t answered = line.stamp.load(std::memory_order_relaxed);
+                const std::uint64_t returned = Backend::ticks();
+                if (round < options.warmupRounds) {
+                    continue;
+                }
+
+                const double there = static_cast<double>(static_cast<std::int64_t>(answered - sent)) * nanosecondsPerTick;
+                const double back = static_cast<double>(static_cast<std::int64_t>(returned - answered)) * nanosecondsPerTick;
+                for (const double step: {there, back}) {
+                    if (step < 0.0) {
+                        ++skew.backwards;
+                        skew.largestBackwards = std::max(skew.largestBackwards, -step);
+                    }
+                }
+                lower = std::max(lower, -back);
+                upper = std::min(upper, there);
+            }
+            responder.join();
+            pinned = pinned && affinity.applied() && responderPinned;
+
+            skew.lowerBound = options.rounds > 0 ? lower : 0.0;
+            skew.upperBound = options.rounds > 0 ? upper : 0.0;
+            skew.offset = (skew.lowerBound + skew.upperBound) / 2.0;
+            return skew;
+        }
+    }
+
+    /**
+     * @brief Checks a clock backend for offsets and backward jumps between every pair of cores.
+     * @tparam Backend The backend to check, for example TscClockBackend.
+     * @param options The cores and the number of round trips per pair.
+     * @return The skew of every pair.
+     */
+    template<typename Backend>
+    inline ClockCheckResult checkClock(const ClockCheckOptions &options = {}) {
+        ClockCheckResult result;
+        result.backend = Backend::name;
+        result.cores = options.cores.empty() ? allowedCores() : options.cores;
+        std::sort(result.cores.begin(), result.cores.end());
+        result.cores.erase(std::unique(result.cores.begin(), result.cores.end()), result.cores.end());
+        for (std::size_t i = 0; i < result.cores.size(); ++i) {
+            for (std::size_t j = i + 1; j < result.cores.size(); ++j) {
+                result.pairs.push_back(detail::checkPair<Backend>(result.cores[i], result.cores[j], options,
+                                                                  result.pinned));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Checks every clock backend timer::time can use: steady_clock, the TSC, and MPI_Wtime in MPI builds.
+     */
+    inline std::vector<ClockCheckResult> checkClocks(const ClockCheckOptions &options = {}) {
+        std::vector<ClockCheckResult> results;
+        results.push_back(checkClock<SteadyClockBackend>(options));
+        if constexpr (TscClockBackend::available) {
+            results.push_back(checkClock<TscClockBackend>(options));
+        }
+#ifdef BUILD_WITH_MPI
+        results.push_back(checkClock<MpiClockBackend>(options));
+#endif
+        return results;
+    }
+
+    /**
+     * @brief Prints the skew matrix of a clock check, in nanoseconds.
+     * Row a, column b holds the offset of b's clock relative to a's. Entries marked ! are inconsistent: the clock went
+     * backwards, or the bounds exclude a zero offset. The bounds of every pair follow the matrix.
+     */
+    inline void printClockCheck(std::ostream &out, const ClockCheckResult &result) {
+        printEnvironmentHeader(out);
+        if (result.pairs.empty()) {
+            out << result.backend << ": INCONCLUSIVE, fewer than two cores to compare\n";
+            return;
+        }
+        if (!result.conclusive()) {
+            out << result.backend << ": INCONCLUSIVE, threads could not be pinned\n";
+        } else {
+            out << result.backend << (result.consistent() ? ": consistent across cores" : ": INCONSISTENT across cores")
+                << '\n';
+        }
+        out << std::setw(8) << "from\\to";
+        for (const unsigned core: result.cores) {
+            out << std::setw(12) << core;
+        }
+        out << '\n';
+        for (std::size_t i = 0; i < result.cores.size(); ++i) {
+            out << std::setw(8) << result.cores[i];
+            for (std::size_t j = 0; j < result.cores.size(); ++j) {
+                const ClockPairSkew *pair = result.find(result.cores[std::min(i, j)], result.cores[std::max(i, j)]);
+                if (i == j || pair == nullptr) {
+                    out << std::setw(12) << "-";
+                    continue;
+                }
+                // The matrix is antisymmetric: b relative to a is minus a relative to b
+                const double offset = i < j ? pair->offset : -pair->offset;
+                out << std::setw(11) << std::lround(offset) << (pair->consistent() ? ' ' : '!');
+            }
+            out << '\n';
+        }
+
+        for (const ClockPairSkew &pair: result.pairs) {
+            out << "  " << pair.from << " -> " << pair.to << ": offset in [" << pair.lowerBound << ", "
+                << pair.upperBound << "] ns, " << pair.backwards << " backward reads";
+            if (pair.backwards > 0) {
+                out << ", largest " << pair.largestBackwards << " ns";
+            }
+            out << (pair.consistent() ? "\n" : "  !\n");
+        }
+    }
+}
+
+#endif //MCKRUEG_TIMER_CLOCK_CHECK_HPP
@@ -0,0 +1,324 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_CLOCKS_HPP
+#define MCKRUEG_TIMER_CLOCKS_HPP
+#include "../timer.hpp"
+#include "environment.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define MCKRUEG_TIMER_HAS_TSC true
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define MCKRUEG_TIMER_HAS_TSC true
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#define MCKRUEG_TIMER_HAS_TSC true
+#else
+#define MCKRUEG_TIMER_HAS_TSC false
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#endif
+
+namespace timer {
+
+    /**
+     * Every clock backend provides the same static interface:
+     *  - name: a printable name.
+     *  - ticks(): a raw, monotonically increasing integer counter. Cheapest to read, and what hot paths should store.
+     *  - ticksPerSecond(): the rate of ticks().
+     *  - now(): the current time as a TimePoint. Like the MPI_Wtime based TimePoint, the epoch is backend specific,
+     *    so only compare time points read from the same backend.
+     *  - resolution(): the resolution the platform reports for the clock.
+     */
+
+    /**
+     * std::chrono::steady_clock (timer::Clock). Portable, and on Linux backed by CLOCK_MONOTONIC through the vDSO.
+     */
+    struct SteadyClockBackend {
+        static constexpr const char *name = "steady_clock";
+
+        static inline std::uint64_t ticks() {
+            return static_cast<std::uint64_t>(Clock::now().time_since_epoch().count());
+        }
+
+        static inline double ticksPerSecond() {
+            return static_cast<double>(Clock::period::den) / static_cast<double>(Clock::period::num);
+        }
+
+        static inline TimePoint now() {
+            return std::chrono::time_point_cast<Duration>(Clock::now());
+        }
+
+        /**
+         * @return clock_getres(CLOCK_MONOTONIC) on POSIX systems, and the period of Clock elsewhere.
+         */
+        static inline Duration resolution() {
+#if defined(__unix__) || defined(__APPLE__)
+            timespec res{};
+            if (clock_getres(CLOCK_MONOTONIC, &res) == 0) {
+                return Duration(static_cast<double>(res.tv_sec) + static_cast<double>(res.tv_nsec) * 1e-9);
+            }
+#endif
+            return Duration(1.0 / ticksPerSecond());
+        }
+    };
+
+    /**
+     * The CPU time stamp counter: rdtsc on x86 and cntvct_el0 on AArch64. Far cheaper to read than the OS clocks.
+     *
+     * On x86 the frequency is not architecturally reported, so it is calibrated against steady_clock on first use
+     * (about 20 ms). The counter is only meaningful on CPUs with an invariant TSC, which is every x86 CPU of the last
+     * decade, and across sockets only if the firmware synchronized them.
+     * On platforms without a usable counter this falls back to steady_clock, and available is false.
+     */
+    struct TscClockBackend {
+        static constexpr const char *name = "tsc";
+        static constexpr bool available = MCKRUEG_TIMER_HAS_TSC;
+
+        static inline std::uint64_t ticks() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+            return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+            std::uint64_t value;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+            return value;
+#else
+            return SteadyClockBackend::ticks();
+#endif
+        }
+
+        static inline double ticksPerSecond() {
+            static const double rate = [] {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+                std::uint64_t frequency;
+                asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+                return static_cast<double>(frequency);
+#else
+                if constexpr (!available) {
+                    return SteadyClockBackend::ticksPerSecond();
+                }
+
+                // Busy wait so the thread stays on one core, and bracket each end with a steady_clock read
+                const auto steadyStart = Clock::now();
+                const std::uint64_t tscStart = ticks();
+                auto steadyEnd = steadyStart;
+                while (steadyEnd - steadyStart < std::chrono::milliseconds(20)) {
+                    steadyEnd = Clock::now();
+                }
+                const std::uint64_t tscEnd = ticks();
+                const double elapsed = std::chrono::duration_cast<Duration>(steadyEnd - steadyStart).count();
+                return static_cast<double>(tscEnd - tscStart) / elapsed;
+#endif
+            }();
+            return rate;
+        }
+
+        static inline TimePoint now() {
+            return TimePoint(Duration(static_cast<double>(ticks()) / ticksPerSecond()));
+        }
+
+        /**
+         * @return One tick. The counter increments by one per tick, though reads are far slower than a tick.
+         */
+        static inline Duration resolution() {
+            return Duration(1.0 / ticksPerSecond());
+        }
+    };
+
+#ifdef BUILD_WITH_MPI
+    /**
+     * MPI_Wtime, the clock timer::time uses when building with MPI. ticks() counts nanoseconds.
+     */
+    struct MpiClockBackend {
+        static constexpr const char *name = "MPI_Wtime";
+
+        static inline std::uint64_t ticks() {
+            return static_cast<std::uint64_t>(MPI_Wtime() * 1e9);
+        }
+
+        static inline double ticksPerSecond() { return 1e9; }
+
+        static inline TimePoint now() { return TimePoint(Duration(MPI_Wtime())); }
+
+        /**
+         * @return MPI_Wtick.
+         */
+        static inline Duration resolution() { return Duration(MPI_Wtick()); }
+    };
+#endif
+
+    /**
+     * The CPU time consumed by the calling thread, from CLOCK_THREAD_CPUTIME_ID. ticks() counts nanoseconds.
+     * Unlike the other backends this does not advance while the thread is blocked or descheduled, so it separates
+     * on-CPU time from waiting. Only available on POSIX systems; elsewhere it always reads zero.
+     */
+    struct ThreadCpuClockBackend {
+        static constexpr const char *name = "thread_cpu";
+#if defined(__unix__) || defined(__APPLE__)
+        static constexpr bool available = true;
+#else
+        static constexpr bool available = false;
+#endif
+
+        static inline std::uint64_t ticks() {
+#if defined(__unix__) || defined(__APPLE__)
+            timespec time{};
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+            return static_cast<std::uint64_t>(time.tv_sec) * 1000000000u + static_cast<std::uint64_t>(time.tv_nsec);
+#else
+            return 0;
+#endif
+        }
+
+        static inline double ticksPerSecond() { return 1e9; }
+
+        static inline TimePoint now() { return TimePoint(Duration(static_cast<double>(ticks()) * 1e-9)); }
+
+        static inline Duration resolution() {
+#if defined(__unix__) || defined(__APPLE__)
+            timespec res{};
+            if (clock_getres(CLOCK_THREAD_CPUTIME_ID, &res) == 0) {
+                return Duration(static_cast<double>(res.tv_sec) + static_cast<double>(res.tv_nsec) * 1e-9);
+            }
+#endif
+            return Duration(1e-9);
+        }
+    };
+
+    /**
+     * A description of a clock backend.
+     */
+    struct ClockInfo {
+        /**
+         * The backend's name.
+         */
+        std::string name;
+
+        /**
+         * The resolution the platform reports: clock_getres, MPI_Wtick, or one counter tick.
+         */
+        Duration reportedResolution;
+
+        /**
+         * The smallest nonzero step observed between consecutive reads. This is what a measurement can actually
+         * resolve, and is never finer than the reported resolution or the cost of a read.
+         */
+        Duration measuredResolution;
+
+        /**
+         * The average cost of one read of the clock.
+         */
+        Duration readCost;
+    };
+
+    /**
+     * Measures a clock backend.
+     * @tparam Backend The backend to measure, for example TscClockBackend.
+     * @param reads The number of reads used for each measurement.
+     * @return The backend's ClockInfo.
+     */
+    template<typename Backend>
+    inline ClockInfo describeClock(int reads = 100000) {
+        reads = std::max(reads, 1);
+        ClockInfo info;
+        info.name = Backend::name;
+        info.reportedResolution = Backend::resolution();
+
+        // Read cost: time a batch of back-to-back reads with the backend itself
+        volatile std::uint64_t sink = 0;
+        const std::uint64_t start = Backend::ticks();
+        for (int i = 0; i < reads; ++i) {
+            sink = Backend::ticks();
+        }
+        const std::uint64_t end = Backend::ticks();
+        (void) sink;
+        info.readCost = Duration(static_cast<double>(end - start) / Backend::ticksPerSecond() / reads);
+
+        // Empirical resolution: the smallest nonzero step between consecutive reads
+        std::uint64_t smallest = ~std::uint64_t{0};
+        for (int i = 0; i < std::min(reads, 1000); ++i) {
+            const std::uint64_t first = Backend::ticks();
+            std::uint64_t second = Backend::ticks();
+            while (second == first) {
+                second = Backend::ticks();
+            }
+            smallest = std::min(smallest, second - first);
+        }
+        info.measuredResolution = Duration(static_cast<double>(smallest) / Backend::ticksPerSecond());
+
+        return info;
+    }
+
+    /**
+     * @return A description of every clock backend available in this build.
+     */
+    inline std::vector<ClockInfo> describeClocks() {
+        std::vector<ClockInfo> clocks;
+        clocks.push_back(describeClock<SteadyClockBackend>());
+        if constexpr (TscClockBackend::available) {
+            clocks.push_back(describeClock<TscClockBackend>());
+        }
+#ifdef BUILD_WITH_MPI
+        clocks.push_back(describeClock<MpiClockBackend>());
+#endif
+        return clocks;
+    }
+
+    /**
+     * Prints a table of ClockInfo, in nanoseconds, after the environment header.
+     */
+    inline void printClocks(std::ostream &out, const std::vector<ClockInfo> &clocks) {
+        printEnvironmentHeader(out);
+        out << std::left << std::setw(16) << "clock" << std::right
+            << std::setw(20) << "reported res (ns)" << std::setw(20) << "measured res (ns)"
+            << std::setw(16) << "read cost (ns)" << '\n';
+        for (const ClockInfo &info: clocks) {
+            out << std::left << std::setw(16) << info.name << std::right
+                << std::setw(20) << nanoseconds(info.reportedResolution).count()
+                << std::setw(20) << nanoseconds(info.measuredResolution).count()
+                << std::setw(16) << nanoseconds(info.readCost).count() << '\n';
+        }
+    }
+}
+
+#endif //MCKRUEG_TIMER_CLOCKS_HPP
@@ -0,0 +1,306 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_COMPARE_HPP
+#define MCKRUEG_TIMER_COMPARE_HPP
+#include "../timer.hpp"
+#include "benchmark.hpp"
+#include "environment.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * Options for comparing two callables.
+     */
+    struct CompareOptions {
+        /**
+         * The number of timed runs of each callable.
+         */
+        std::size_t iterations = 30;
+
+        /**
+         * The number of untimed runs of each callable before the timed ones.
+         */
+        std::size_t warmupIterations = 3;
+
+        /**
+         * The number of bootstrap resamples behind the confidence interval.
+         */
+        std::size_t bootstrapResamples = 2000;
+
+        /**
+         * The confidence level of the speedup interval.
+         */
+        double confidence = 0.95;
+
+        /**
+         * The significance level of the Mann-Whitney U test.
+         */
+        double alpha = 0.05;
+
+        /**
+         * Seeds the run order and the bootstrap, so a comparison can be repeated exactly.
+         */
+        std::uint64_t seed = 1;
+
+        /**
+         * The bytes each run of either callable processes. When nonzero, both results report a byte rate.
+         */
+        std::uint64_t bytesPerIteration = 0;
+
+        /**
+         * The items each run of either callable processes. When nonzero, both results report an item rate.
+         */
+        std::uint64_t itemsPerIteration = 0;
+    };
+
+    /**
+     * Whether the second callable of a comparison is faster than the first.
+     */
+    enum class CompareVerdict {
+        Faster,
+        Slower,
+        Indistinguishable
+    };
+
+    inline const char *verdictName(CompareVerdict verdict) {
+        switch (verdict) {
+            case CompareVerdict::Faster:
+                return "faster";
+            case CompareVerdict::Slower:
+                return "slower";
+            default:
+                return "indistinguishable";
+        }
+    }
+
+    /**
+     * The result of comparing a baseline A with a candidate B.
+     */
+    struct CompareResult {
+        BenchmarkResult a;
+        BenchmarkResult b;
+
+        /**
+         * The median of A divided by the median of B. Above one means B is faster.
+         */
+        double speedup = 1.0;
+
+        /**
+         * The bootstrap confidence interval of the speedup.
+         */
+        double speedupLow = 1.0;
+        double speedupHigh = 1.0;
+
+        /**
+         * The Mann-Whitney U statistic of A's samples against B's.
+         */
+        double u = 0.0;
+
+        /**
+         * The two-sided p-value of the U test, from its normal approximation with a tie correction.
+         */
+        double pValue = 1.0;
+
+        CompareVerdict verdict = CompareVerdict::Indistinguishable;
+    };
+
+    namespace detail {
+        inline Duration medianOf(std::vector<Duration> samples) {
+            std::sort(samples.begin(), samples.end());
+            return quantileOfSorted(samples, 0.5);
+        }
+
+        /**
+         * @return The U statistic of a against b, and its two-sided p-value.
+         */
+        inline std::pair<double, double> mannWhitneyU(const std::vector<Duration> &a, const std::vector<Duration> &b) {
+            std::vector<std::pair<Duration, bool> > pooled;
+            pooled.reserve(a.size() + b.size());
+            for (const Duration &sample: a) {
+                pooled.emplace_back(sample, true);
+            }
+            for (const Duration &sample: b) {
+                pooled.emplace_back(sample, false);
+            }
+            std::sort(pooled.begin(), pooled.end());
+
+            // Rank the pooled samples, giving tied values their average rank
+            double rankSumA = 0.0;
+            double tieTerm = 0.0;
+            for (std::size_t first = 0; first < pooled.size();) {
+                std::size_t last = first;
+                while (last + 1 < pooled.size() && pooled[last + 1].first == pooled[first].first) {
+                    ++last;
+                }
+                const double rank = (static_cast<double>(first + last) / 2.0) + 1.0;
+                const auto ties = static_cast<double>(last - first + 1);
+                tieTerm += ties * ties * ties - ties;
+                for (std::size_t i = first; i <= last; ++i) {
+                    rankSumA += pooled[i].second ? rank : 0.0;
+                }
+                first = last + 1;
+            }
+
+            const auto na = static_cast<double>(a.size());
+            const auto nb = static_cast<double>(b.size());
+            const double n = na + nb;
+            const double u = rankSumA - na * (na + 1.0) / 2.0;
+            const double mean = na * nb / 2.0;
+            const double variance = na * nb / 12.0 * ((n + 1.0) - tieTerm / (n * (n - 1.0)));
+            if (!(variance > 0.0)) {
+                return {u, 1.0};
+            }
+
+            // Continuity corrected normal approximation
+            const double z = std::max(std::abs(u - mean) - 0.5, 0.0) / std::sqrt(variance);
+            return {u, std::erfc(z / std::sqrt(2.0))};
+        }
+    }
+
+    /**
+     * @brief Decides whether candidate B is faster than baseline A.
+     *
+     * Runs of A and B are interleaved, and the order within each pair is chosen at random, so slow drift in the
+     * machine (frequency, thermal state, background load) affects both equally. The speedup is the ratio of the
+     * medians, with a percentile bootstrap confidence interval. B is reported faster or slower only if the
+     * Mann-Whitney U test rejects equal distributions and the confidence interval excludes one.
+     *
+     * @param a The baseline.
+     * @param b The candidate.
+     * @param options Run counts, confidence and significance levels, and the random seed.
+     * @return Both sets of samples, the speedup with its interval, the U test and the verdict.
+     */
+    template<typename FuncA, typename FuncB>
+    inline CompareResult compare(FuncA &&a, FuncB &&b, const CompareOptions &options = {}) {
+        if (benchmarkingRefused()) {
+            return CompareResult{};
+        }
+        for (std::size_t i = 0; i < options.warmupIterations; ++i) {
+            a();
+            b();
+        }
+
+        CompareResult result;
+        result.a.samples.reserve(options.iterations);
+        result.b.samples.reserve(options.iterations);
+
+        std::mt19937_64 random(options.seed);
+        std::bernoulli_distribution aFirst(0.5);
+        const auto runA = [&] { result.a.samples.push_back(time([&a] { return a(); }).duration); };
+        const auto runB = [&] { result.b.samples.push_back(time([&b] { return b(); }).duration); };
+        for (std::size_t i = 0; i < options.iterations; ++i) {
+            if (aFirst(random)) {
+                runA();
+                runB();
+            } else {
+                runB();
+                runA();
+            }
+        }
+
+        result.a.stats = summarize(result.a.samples);
+        result.b.stats = summarize(result.b.samples);
+        result.a.throughput = throughputOf(result.a.samples, options.bytesPerIteration, options.itemsPerIteration);
+        result.b.throughput = throughputOf(result.b.samples, options.bytesPerIteration, options.itemsPerIteration);
+        if (options.iterations == 0 || !(result.b.stats.median.count() > 0.0)) {
+            return result;
+        }
+        result.speedup = result.a.stats.median / result.b.stats.median;
+
+        std::vector<double> ratios;
+        ratios.reserve(options.bootstrapResamples);
+        std::uniform_int_distribution<std::size_t> pick(0, options.iterations - 1);
+        std::vector<Duration> resampleA(options.iterations);
+        std::vector<Duration> resampleB(options.iterations);
+        for (std::size_t r = 0; r < options.bootstrapResamples; ++r) {
+            for (std::size_t i = 0; i < options.iterations; ++i) {
+                resampleA[i] = result.a.samples[pick(random)];
+                resampleB[i] = result.b.samples[pick(random)];
+            }
+            const Duration medianB = detail::medianOf(resampleB);
+            if (medianB.count() > 0.0) {
+                ratios.push_back(detail::medianOf(resampleA) / medianB);
+            }
+        }
+        if (!ratios.empty()) {
+            std::sort(ratios.begin(), ratios.end());
+            const double tail = (1.0 - options.confidence) / 2.0;
+            const auto at = [&](double q) {
+                return ratios[static_cast<std::size_t>(std::round(q * static_cast<double>(ratios.size() - 1)))];
+            };
+            result.speedupLow = at(tail);
+            result.speedupHigh = at(1.0 - tail);
+        }
+
+        std::tie(result.u, result.pValue) = detail::mannWhitneyU(result.a.samples, result.b.samples);
+        if (result.pValue < options.alpha && result.speedupLow > 1.0) {
+            result.verdict = CompareVerdict::Faster;
+        } else if (result.pValue < options.alpha && result.speedupHigh < 1.0) {
+            result.verdict = CompareVerdict::Slower;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Prints both medians and throughputs, the speedup with its interval, the p-value and the verdict.
+     */
+    inline void printComparison(std::ostream &out, const CompareResult &result, const char *nameA = "A",
+                                const char *nameB = "B") {
+        printEnvironmentHeader(out);
+        const auto variant = [&](const char *name, const BenchmarkResult &variantResult) {
+            out << name << ": median " << microseconds(variantResult.stats.median).count() << " us, MAD "
+                << microseconds(variantResult.stats.mad).count() << " us";
+            if (!variantResult.throughput.empty()) {
+                out << ", " << formatThroughput(variantResult.throughput);
+            }
+            out << '\n';
+        };
+        variant(nameA, result.a);
+        variant(nameB, result.b);
+        out << "speedup " << result.speedup << "x [" << result.speedupLow << ", " << result.speedupHigh
+            << "], Mann-Whitney p = " << result.pValue << '\n'
+            << nameB << " is " << verdictName(result.verdict)
+            << (result.verdict == CompareVerdict::Indistinguishable ? " from " : " than ") << nameA << '\n';
+    }
+}
+
+#endif //MCKRUEG_TIMER_COMPARE_HPP
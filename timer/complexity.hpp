@@ -0,0 +1,342 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_COMPLEXITY_HPP
+#define MCKRUEG_TIMER_COMPLEXITY_HPP
+#include "../timer.hpp"
+#include "benchmark.hpp"
+#include "environment.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * The growth models a size sweep is fitted against.
+     */
+    enum class Complexity {
+        Constant,
+        Logarithmic,
+        Linear,
+        Linearithmic,
+        Quadratic,
+        Cubic
+    };
+
+    inline const char *complexityName(Complexity complexity) {
+        switch (complexity) {
+            case Complexity::Constant:
+                return "O(1)";
+            case Complexity::Logarithmic:
+                return "O(log n)";
+            case Complexity::Linear:
+                return "O(n)";
+            case Complexity::Linearithmic:
+                return "O(n log n)";
+            case Complexity::Quadratic:
+                return "O(n^2)";
+            default:
+                return "O(n^3)";
+        }
+    }
+
+    /**
+     * @return The growth function of a model at n.
+     */
+    inline double complexityAt(Complexity complexity, double n) {
+        switch (complexity) {
+            case Complexity::Constant:
+                return 1.0;
+            case Complexity::Logarithmic:
+                return std::log2(n);
+            case Complexity::Linear:
+                return n;
+            case Complexity::Linearithmic:
+                return n * std::log2(n);
+            case Complexity::Quadratic:
+                return n * n;
+            default:
+                return n * n * n;
+        }
+    }
+
+    /**
+     * Options for a size sweep.
+     */
+    struct ComplexityOptions {
+        std::size_t minSize = 16;
+        std::size_t maxSize = std::size_t{1} << 16;
+
+        /**
+         * The ratio between consecutive sizes. Must be above one.
+         */
+        double growth = 2.0;
+        BenchmarkOptions benchmark{};
+
+        /**
+         * The bytes each run processes per unit of n, added to benchmark.bytesPerIteration at each size.
+         */
+        std::uint64_t bytesPerElement = 0;
+
+        /**
+         * The items each run processes per unit of n, added to benchmark.itemsPerIteration at each size.
+         */
+        std::uint64_t itemsPerElement = 0;
+    };
+
+    /**
+     * The timings at one size.
+     */
+    struct ComplexityPoint {
+        std::size_t n = 0;
+        SampleStats stats;
+
+        /**
+         * The bytes and items each run processed at this size, zero if no count was given.
+         */
+        std::uint64_t bytesProcessed = 0;
+        std::uint64_t itemsProcessed = 0;
+
+        /**
+         * The throughput at this size, if a byte or item count was given.
+         */
+        Throughput throughput;
+    };
+
+    /**
+     * One growth model fitted to a size sweep.
+     */
+    struct ComplexityFit {
+        Complexity complexity = Complexity::Constant;
+
+        /**
+         * The fixed cost in seconds, so that time(n) is about intercept + coefficient * f(n).
+         */
+        double intercept = 0.0;
+
+        /**
+         * The seconds per unit of the growth function.
+         */
+        double coefficient = 0.0;
+
+        /**
+         * The root mean square of the fit's error at each size, relative to the time measured there.
+         */
+        double rms = 0.0;
+    };
+
+    /**
+     * A size sweep and every model fitted to it.
+     */
+    struct ComplexityResult {
+        std::vector<ComplexityPoint> points;
+
+        /**
+         * Every model, best fit first.
+         */
+        std::vector<ComplexityFit> fits;
+
+        /**
+         * @return The best model: the simplest one whose RMS error is close to the lowest. Null if nothing was fitted,
+         * for example because minSize was above maxSize.
+         */
+        inline const ComplexityFit *best() const { return fits.empty() ? nullptr : &fits.front(); }
+    };
+
+    namespace detail {
+        /**
+         * The median time at a size, kept away from zero so it can divide.
+         */
+        inline double measuredTime(const ComplexityPoint &point) {
+            return std::max(point.stats.median.count(), 1e-12);
+        }
+    }
+
+    /**
+     * @brief Fits every growth model to a set of (n, time) points by least squares, as a fixed cost plus a growing one.
+     *
+     * Each model is fitted as time(n) = intercept + coefficient * f(n), with neither term negative, so a per-call
+     * setup cost does not push a linear kernel towards O(log n). The median time at each size is used. Errors are
+     * taken relative to the measured time, so that on a geometric range of sizes the largest sizes do not decide the
+     * fit alone.
+     *
+     * Every model includes a constant term, so on flat data they all fit about equally well. The simplest model whose
+     * RMS error is within a quarter, plus half a percent, of the lowest is therefore moved to the front.
+     *
+     * @return Every model, best first, then by RMS error.
+     */
+    inline std::vector<ComplexityFit> fitComplexity(const std::vector<ComplexityPoint> &points) {
+        std::vector<ComplexityFit> fits;
+        if (points.empty()) {
+            return fits;
+        }
+
+        for (const Complexity complexity: {Complexity::Constant, Complexity::Logarithmic, Complexity::Linear,
+                                           Complexity::Linearithmic, Complexity::Quadratic, Complexity::Cubic}) {
+            // Weighted least squares of t = c0 + c1 f, with weights 1 / t^2 so the residuals are relative
+            double weights = 0.0;
+            double sumF = 0.0;
+            double sumT = 0.0;
+            double sumFF = 0.0;
+            double sumFT = 0.0;
+            for (const ComplexityPoint &point: points) {
+                const double t = detail::measuredTime(point);
+                const double f = complexityAt(complexity, static_cast<double>(point.n));
+                const double weight = 1.0 / (t * t);
+                weights += weight;
+                sumF += weight * f;
+                sumT += weight * t;
+                sumFF += weight * f * f;
+                sumFT += weight * f * t;
+            }
+
+            ComplexityFit fit;
+            fit.complexity = complexity;
+            const double determinant = weights * sumFF - sumF * sumF;
+            if (complexity != Complexity::Constant && determinant > 0.0) {
+                fit.coefficient = (weights * sumFT - sumF * sumT) / determinant;
+                fit.intercept = (sumT - fit.coefficient * sumF) / weights;
+            }
+            if (complexity == Complexity::Constant || determinant <= 0.0 || fit.coefficient < 0.0) {
+                // A shrinking cost is no growth at all: the best model is the constant one
+                fit.coefficient = 0.0;
+                fit.intercept = sumT / weights;
+            } else if (fit.intercept < 0.0) {
+                // Through the origin: minimizing sum(((t - c f) / t)^2) gives c = sum(f / t) / sum((f / t)^2)
+                fit.intercept = 0.0;
+                fit.coefficient = sumFF > 0.0 ? sumFT / sumFF : 0.0;
+            }
+
+            double residuals = 0.0;
+            for (const ComplexityPoint &point: points) {
+                const double predicted =
+                        fit.intercept + fit.coefficient * complexityAt(complexity, static_cast<double>(point.n));
+                const double error = 1.0 - predicted / detail::measuredTime(point);
+                residuals += error * error;
+            }
+            fit.rms = std::sqrt(residuals / static_cast<double>(points.size()));
+            fits.push_back(fit);
+        }
+
+        std::stable_sort(fits.begin(), fits.end(),
+                         [](const ComplexityFit &a, const ComplexityFit &b) { return a.rms < b.rms; });
+        const double tolerance = fits.front().rms * 1.25 + 0.005;
+        auto simplest = fits.begin();
+        for (auto fit = fits.begin(); fit != fits.end(); ++fit) {
+            if (fit->rms <= tolerance && fit->complexity < simplest->complexity) {
+                simplest = fit;
+            }
+        }
+        std::rotate(fits.begin(), simplest, simplest + 1);
+        return fits;
+    }
+
+    /**
+     * @brief Times a callable over a geometric range of sizes and fits the growth models to the results.
+     *
+     * Each size is benchmarked with timer::benchmark, so the timings include anything the callable does. Build the
+     * input outside the timed call where possible, or the fit describes the setup as well.
+     *
+     * @param workload Called with the size n.
+     * @param options The range of sizes, their spacing and the runs per size.
+     * @return The timings at each size and every fitted model, best first.
+     */
+    template<typename Workload>
+    inline ComplexityResult complexitySweep(Workload &&workload, const ComplexityOptions &options = {}) {
+        ComplexityResult result;
+        if (benchmarkingRefused()) {
+            return result;
+        }
+        const double growth = std::max(options.growth, 1.01);
+        for (double size = static_cast<double>(std::max<std::size_t>(options.minSize, 1));
+             size <= static_cast<double>(options.maxSize); size *= growth) {
+            const auto n = static_cast<std::size_t>(std::llround(size));
+            if (!result.points.empty() && result.points.back().n == n) {
+                continue;
+            }
+            BenchmarkOptions runOptions = options.benchmark;
+            runOptions.bytesPerIteration += options.bytesPerElement * n;
+            runOptions.itemsPerIteration += options.itemsPerElement * n;
+            const BenchmarkResult measured = benchmark([&] { workload(n); }, runOptions);
+
+            ComplexityPoint point;
+            point.n = n;
+            point.stats = measured.stats;
+            point.bytesProcessed = runOptions.bytesPerIteration;
+            point.itemsProcessed = runOptions.itemsPerIteration;
+            point.throughput = measured.throughput;
+            result.points.push_back(point);
+        }
+        result.fits = fitComplexity(result.points);
+        return result;
+    }
+
+    /**
+     * @brief Prints the median time at each size, with its throughput when it was measured, then every model with its
+     * fixed cost, coefficient and RMS error.
+     */
+    inline void printComplexityReport(std::ostream &out, const ComplexityResult &result) {
+        printEnvironmentHeader(out);
+        const bool hasThroughput = std::any_of(result.points.begin(), result.points.end(),
+                                               [](const ComplexityPoint &point) { return !point.throughput.empty(); });
+        out << std::setw(12) << "n" << std::setw(16) << "median (us)";
+        if (hasThroughput) {
+            out << "  throughput";
+        }
+        out << '\n';
+        for (const ComplexityPoint &point: result.points) {
+            out << std::setw(12) << point.n << std::setw(16) << microseconds(point.stats.median).count();
+            if (hasThroughput) {
+                out << "  " << formatThroughput(point.throughput);
+            }
+            out << '\n';
+        }
+        out << std::setw(12) << "model" << std::setw(16) << "intercept (us)" << std::setw(16) << "coefficient"
+            << std::setw(12) << "rms" << '\n';
+        for (const ComplexityFit &fit: result.fits) {
+            out << std::setw(12) << complexityName(fit.complexity) << std::setw(16) << fit.intercept * 1e6
+                << std::setw(16) << fit.coefficient << std::setw(11) << fit.rms * 100.0 << "%\n";
+        }
+        if (const ComplexityFit *best = result.best()) {
+            out << "best fit: " << complexityName(best->complexity) << '\n';
+        } else {
+            out << "no sizes were measured\n";
+        }
+    }
+}
+
+#endif //MCKRUEG_TIMER_COMPLEXITY_HPP
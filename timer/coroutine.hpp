@@ -0,0 +1,240 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_COROUTINE_HPP
+#define MCKRUEG_TIMER_COROUTINE_HPP
+#include "../timer.hpp"
+#include "clocks.hpp"
+
+// The library itself is C++17. Coroutine support is only declared when the including translation unit is compiled
+// with C++20 coroutines, and this header declares nothing otherwise.
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define MCKRUEG_TIMER_HAS_COROUTINES true
+#endif
+#endif
+
+#ifdef MCKRUEG_TIMER_HAS_COROUTINES
+#include <coroutine>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace timer {
+
+    /**
+     * The result of a timed co_await.
+     * TimeResult<T>::duration holds the wall time from the start of the co_await until the awaiting coroutine resumed
+     * and received the result.
+     *
+     * @tparam T Type of the awaited result.
+     */
+    template<typename T>
+    struct AwaitTimeResult : TimeResult<T> {
+        /**
+         * CPU time the awaiting coroutine's thread spent on this co_await outside of suspension, measured with
+         * ThreadCpuClockBackend on each side of the suspension point. This is the cost of the await machinery and of
+         * any work the awaitable does inline; it excludes whatever the resumer's thread did meanwhile.
+         */
+        Duration cpuDuration;
+
+        /**
+         * The wall time between suspending and resuming. Zero if the awaitable was ready without suspending.
+         */
+        Duration suspendedDuration;
+
+        /**
+         * True if the coroutine was suspended.
+         */
+        bool suspended = false;
+    };
+
+    namespace detail {
+        template<typename Awaitable, typename = void>
+        struct has_member_co_await : std::false_type {
+        };
+
+        template<typename Awaitable>
+        struct has_member_co_await<Awaitable, std::void_t<decltype(std::declval<Awaitable>().operator co_await())> >
+            : std::true_type {
+        };
+
+        template<typename Awaitable, typename = void>
+        struct has_free_co_await : std::false_type {
+        };
+
+        template<typename Awaitable>
+        struct has_free_co_await<Awaitable, std::void_t<decltype(operator co_await(std::declval<Awaitable>()))> >
+            : std::true_type {
+        };
+
+        /**
+         * Obtains the awaiter of an awaitable the way co_await does.
+         */
+        template<typename Awaitable>
+        inline decltype(auto) getAwaiter(Awaitable &&awaitable) {
+            if constexpr (has_member_co_await<Awaitable>::value) {
+                return std::forward<Awaitable>(awaitable).operator co_await();
+            } else if constexpr (has_free_co_await<Awaitable>::value) {
+                return operator co_await(std::forward<Awaitable>(awaitable));
+            } else {
+                return std::forward<Awaitable>(awaitable);
+            }
+        }
+    }
+
+    /**
+     * An awaiter that forwards to another awaitable and records the wall and CPU time around its suspension point.
+     * Created by timer::timed. It is an ordinary awaiter rather than a coroutine, so no coroutine frame is allocated.
+     */
+    template<typename Awaitable>
+    class TimedAwaiter {
+        // An awaitable that is its own awaiter is used in place. Only an awaiter returned by value is stored.
+        using AwaiterExpression = decltype(detail::getAwaiter(std::declval<Awaitable>()));
+        using Awaiter = std::remove_reference_t<AwaiterExpression>;
+        using AwaiterStorage = std::conditional_t<std::is_reference_v<AwaiterExpression>, Awaiter *,
+            std::optional<Awaiter> >;
+        using ResultType = std::decay_t<decltype(std::declval<Awaiter &>().await_resume())>;
+
+    public:
+        inline explicit TimedAwaiter(Awaitable &&awaitable) : m_Awaitable(std::forward<Awaitable>(awaitable)) {}
+
+        inline bool await_ready() {
+            m_Start = now();
+            m_CpuStart = ThreadCpuClockBackend::ticks();
+            if constexpr (std::is_reference_v<AwaiterExpression>) {
+                auto &&awaiter = detail::getAwaiter(std::forward<Awaitable>(m_Awaitable));
+                m_Awaiter = std::addressof(awaiter);
+            } else {
+                m_Awaiter.emplace(detail::getAwaiter(std::forward<Awaitable>(m_Awaitable)));
+            }
+            return m_Awaiter->await_ready();
+        }
+
+        template<typename Promise>
+        inline auto await_suspend(std::coroutine_handle<Promise> handle) {
+            // Take the suspend boundary first: once the inner awaiter has the handle, another thread may resume it
+            m_Suspended = true;
+            m_CpuAtSuspend = ThreadCpuClockBackend::ticks();
+            m_SuspendedAt = now();
+
+            // The inner awaiter may still decline to suspend, by returning false or this coroutine's own handle. The
+            // coroutine then resumes on this thread without anyone else having it, so the flag can be cleared.
+            using SuspendResult = decltype(m_Awaiter->await_suspend(handle));
+            if constexpr (std::is_same_v<SuspendResult, bool>) {
+                const bool suspended = m_Awaiter->await_suspend(handle);
+                if (!suspended) {
+                    m_Suspended = false;
+                }
+                return suspended;
+            } else if constexpr (std::is_void_v<SuspendResult>) {
+                m_Awaiter->await_suspend(handle);
+            } else {
+                auto next = m_Awaiter->await_suspend(handle);
+                if (next.address() == handle.address()) {
+                    m_Suspended = false;
+                }
+                return next;
+            }
+        }
+
+        inline AwaitTimeResult<ResultType> await_resume() {
+            const TimePoint resumedAt = now();
+            const std::uint64_t cpuAtResume = ThreadCpuClockBackend::ticks();
+
+            if constexpr (std::is_void_v<ResultType>) {
+                m_Awaiter->await_resume();
+                AwaitTimeResult<void> result{};
+                finish(result, resumedAt, cpuAtResume);
+                return result;
+            } else {
+                AwaitTimeResult<ResultType> result{
+                    {m_Awaiter->await_resume(), Duration(0.0)}, Duration(0.0), Duration(0.0), false
+                };
+                finish(result, resumedAt, cpuAtResume);
+                return result;
+            }
+        }
+
+    private:
+        template<typename Result>
+        inline void finish(Result &result, TimePoint resumedAt, std::uint64_t cpuAtResume) const {
+            const TimePoint end = now();
+            const std::uint64_t cpuEnd = ThreadCpuClockBackend::ticks();
+
+            std::uint64_t cpuTicks = cpuEnd - cpuAtResume;
+            if (m_Suspended) {
+                cpuTicks += m_CpuAtSuspend - m_CpuStart;
+                result.suspendedDuration = resumedAt - m_SuspendedAt;
+            } else {
+                cpuTicks = cpuEnd - m_CpuStart;
+                result.suspendedDuration = Duration(0.0);
+            }
+
+            result.duration = end - m_Start;
+            result.cpuDuration = Duration(static_cast<double>(cpuTicks) / ThreadCpuClockBackend::ticksPerSecond());
+            result.suspended = m_Suspended;
+        }
+
+        Awaitable m_Awaitable;
+        AwaiterStorage m_Awaiter{};
+        TimePoint m_Start;
+        TimePoint m_SuspendedAt;
+        std::uint64_t m_CpuStart = 0;
+        std::uint64_t m_CpuAtSuspend = 0;
+        bool m_Suspended = false;
+    };
+
+    /**
+     * @brief Wraps an awaitable so that co_await yields an AwaitTimeResult with its wall and CPU time.
+     *
+     * @code
+     * auto result = co_await timer::timed(socket.read(buffer));
+     * result.functionResult;     // what co_await socket.read(buffer) would have produced
+     * result.duration;           // wall time of the co_await
+     * result.cpuDuration;        // CPU time outside of suspension
+     * result.suspendedDuration;  // time spent suspended
+     * @endcode
+     *
+     * @note The CPU time of a co_await that resumes on a different thread combines the two threads' clocks around the
+     * suspension point, which is what it should be.
+     * @param awaitable The awaitable. Temporaries are moved into the wrapper, lvalues are referenced.
+     * @return The wrapping awaiter.
+     */
+    template<typename Awaitable>
+    inline TimedAwaiter<Awaitable> timed(Awaitable &&awaitable) {
+        return TimedAwaiter<Awaitable>(std::forward<Awaitable>(awaitable));
+    }
+}
+
+#endif // MCKRUEG_TIMER_HAS_COROUTINES
+
+#endif //MCKRUEG_TIMER_COROUTINE_HPP
@@ -0,0 +1,476 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_ENVIRONMENT_HPP
+#define MCKRUEG_TIMER_ENVIRONMENT_HPP
+#include "../timer.hpp"
+#include "platform.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace timer {
+
+    /**
+     * Whether the CPU may clock above its base frequency.
+     */
+    enum class TurboState {
+        Unknown,
+        Enabled,
+        Disabled
+    };
+
+    /**
+     * The conditions a benchmark runs under that change its results. Everything is read from sysfs and procfs, so
+     * off Linux most fields are empty or unknown.
+     */
+    struct Environment {
+        std::string cpuModel;
+        std::string compiler;
+
+        /**
+         * The cpufreq governor of the benchmark core. Empty if the platform does not report one.
+         */
+        std::string governor;
+        TurboState turbo = TurboState::Unknown;
+
+        /**
+         * True if simultaneous multithreading is switched on.
+         */
+        bool smtActive = false;
+
+        /**
+         * The other logical cores sharing the benchmark core's physical core.
+         */
+        std::vector<unsigned> smtSiblings;
+
+        /**
+         * The cores isolated from the scheduler with isolcpus.
+         */
+        std::vector<unsigned> isolatedCores;
+
+        /**
+         * The cores the process may run on.
+         */
+        std::vector<unsigned> allowedCores;
+
+        /**
+         * The core the thread runs on, or is pinned to. -1 if unknown.
+         */
+        int core = -1;
+        bool pinned = false;
+        bool priorityRaised = false;
+
+        /**
+         * The one minute load average.
+         */
+        double loadAverage = 0.0;
+    };
+
+    namespace detail {
+        inline std::string readFirstLine(const std::string &path) {
+            std::ifstream in(path);
+            std::string line;
+            std::getline(in, line);
+            return line;
+        }
+
+        inline std::string trim(const std::string &text) {
+            const auto first = text.find_first_not_of(" \t\r\n");
+            if (first == std::string::npos) {
+                return {};
+            }
+            return text.substr(first, text.find_last_not_of(" \t\r\n") - first + 1);
+        }
+
+        /**
+         * Parses a kernel CPU list, such as "0-3,8,10-11".
+         */
+        inline std::vector<unsigned> parseCpuList(const std::string &list) {
+            std::vector<unsigned> cores;
+            std::stringstream stream(list);
+            for (std::string range; std::getline(stream, range, ',');) {
+                range = trim(range);
+                if (range.empty()) {
+                    continue;
+                }
+                const auto dash = range.find('-');
+                const auto first = static_cast<unsigned>(std::strtoul(range.c_str(), nullptr, 10));
+                const auto last = dash == std::string::npos
+                                      ? first
+                                      : static_cast<unsigned>(std::strtoul(range.c_str() + dash + 1, nullptr, 10));
+                for (unsigned core = first; core <= last; ++core) {
+                    cores.push_back(core);
+                }
+            }
+            return cores;
+        }
+
+        inline std::string cpuModel() {
+            std::ifstream in("/proc/cpuinfo");
+            std::string line;
+            while (std::getline(in, line)) {
+                const auto colon = line.find(':');
+                const std::string key = trim(line.substr(0, colon));
+                if (colon != std::string::npos && (key == "model name" || key == "Hardware" || key == "cpu model")) {
+                    return trim(line.substr(colon + 1));
+                }
+            }
+            return "unknown";
+        }
+
+        inline std::string compilerName() {
+#if defined(__clang__)
+            return "clang " __clang_version__;
+#elif defined(__GNUC__)
+            return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+            return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+            return "unknown";
+#endif
+        }
+
+        inline TurboState turboState() {
+            // intel_pstate reports the inverse; acpi-cpufreq and amd-pstate report boost directly
+            const std::string noTurbo = trim(readFirstLine("/sys/devices/system/cpu/intel_pstate/no_turbo"));
+            if (!noTurbo.empty()) {
+                return noTurbo == "1" ? TurboState::Disabled : TurboState::Enabled;
+            }
+            const std::string boost = trim(readFirstLine("/sys/devices/system/cpu/cpufreq/boost"));
+            if (!boost.empty()) {
+                return boost == "1" ? TurboState::Enabled : TurboState::Disabled;
+            }
+            return TurboState::Unknown;
+        }
+
+        inline int currentCore() {
+#if defined(__linux__)
+            return sched_getcpu();
+#else
+            return -1;
+#endif
+        }
+
+        inline std::string joinCores(const std::vector<unsigned> &cores) {
+            std::string text;
+            for (const unsigned core: cores) {
+                text += (text.empty() ? "" : ",") + std::to_string(core);
+            }
+            return text.empty() ? "none" : text;
+        }
+    }
+
+    /**
+     * @brief Reads the conditions the calling thread runs under.
+     * @param core The core to describe. Defaults to the one the thread is running on now.
+     */
+    inline Environment probeEnvironment(int core = detail::currentCore()) {
+        Environment environment;
+        environment.cpuModel = detail::cpuModel();
+        environment.compiler = detail::compilerName();
+        environment.core = core;
+        environment.turbo = detail::turboState();
+        environment.smtActive = detail::trim(detail::readFirstLine("/sys/devices/system/cpu/smt/active")) == "1";
+        environment.isolatedCores = detail::parseCpuList(detail::readFirstLine("/sys/devices/system/cpu/isolated"));
+        environment.allowedCores = allowedCores();
+
+        std::istringstream(detail::readFirstLine("/proc/loadavg")) >> environment.loadAverage;
+
+        const std::string cpu = "/sys/devices/system/cpu/cpu" + std::to_string(std::max(core, 0));
+        environment.governor = detail::trim(detail::readFirstLine(cpu + "/cpufreq/scaling_governor"));
+        for (const unsigned sibling: detail::parseCpuList(detail::readFirstLine(cpu + "/topology/thread_siblings_list"))) {
+            if (static_cast<int>(sibling) != core) {
+                environment.smtSiblings.push_back(sibling);
+            }
+        }
+        return environment;
+    }
+
+    /**
+     * @return A description of every condition likely to add noise to measurements. Empty if there are none.
+     */
+    inline std::vector<std::string> environmentWarnings(const Environment &environment) {
+        std::vector<std::string> warnings;
+        if (!environment.governor.empty() && environment.governor != "performance") {
+            warnings.push_back("cpufreq governor is '" + environment.governor + "', not 'performance'");
+        }
+        if (environment.turbo == TurboState::Enabled) {
+            warnings.push_back("turbo boost is enabled, so the clock depends on temperature and load");
+        }
+        if (environment.smtActive && !environment.smtSiblings.empty()) {
+            warnings.push_back("SMT siblings of core " + std::to_string(environment.core) + " are online ("
+                               + detail::joinCores(environment.smtSiblings) + ")");
+        }
+        if (!environment.pinned) {
+            warnings.push_back("the thread is not pinned, so it may migrate between cores");
+        } else if (!environment.isolatedCores.empty()
+                   && std::find(environment.isolatedCores.begin(), environment.isolatedCores.end(),
+                                static_cast<unsigned>(environment.core)) == environment.isolatedCores.end()) {
+            warnings.push_back("core " + std::to_string(environment.core) + " is not one of the isolated cores");
+        }
+        if (environment.loadAverage > 1.0) {
+            warnings.push_back("the load average is " + std::to_string(environment.loadAverage));
+        }
+        return warnings;
+    }
+
+    /**
+     * @return The environment as one line, for the header of a report.
+     */
+    inline std::string describeEnvironment(const Environment &environment) {
+        std::ostringstream out;
+        out << environment.cpuModel << "; " << environment.compiler
+            << "; governor " << (environment.governor.empty() ? "unknown" : environment.governor)
+            << "; turbo " << (environment.turbo == TurboState::Enabled
+                                  ? "on"
+                                  : environment.turbo == TurboState::Disabled ? "off" : "unknown")
+            << "; SMT " << (environment.smtActive ? "on" : "off")
+            << "; core " << environment.core << (environment.pinned ? " (pinned)" : " (unpinned)")
+            << "; isolated cores " << detail::joinCores(environment.isolatedCores)
+            << "; priority " << (environment.priorityRaised ? "raised" : "normal")
+            << "; load " << environment.loadAverage;
+        return out.str();
+    }
+
+    /**
+     * What a BenchmarkEnvironment does when the environment is noisy.
+     */
+    enum class NoisePolicy {
+        Ignore,
+
+        /**
+         * Print every warning.
+         */
+        Warn,
+
+        /**
+         * Print every warning, and refuse to benchmark: while the BenchmarkEnvironment exists, the runners in this
+         * library return empty results without running anything, and PerfCheck exits with 2.
+         */
+        Refuse
+    };
+
+    /**
+     * Options for preparing the calling thread to run benchmarks.
+     */
+    struct EnvironmentOptions {
+        /**
+         * Pin the thread to one core.
+         */
+        bool pin = true;
+
+        /**
+         * The core to pin to. -1 picks the first isolated core the process may use, or else its last allowed core,
+         * which tends to see fewer interrupts than core 0.
+         */
+        int core = -1;
+
+        /**
+         * Raise the thread's priority to nice -20, which needs CAP_SYS_NICE.
+         */
+        bool raisePriority = true;
+
+        /**
+         * Run under SCHED_FIFO instead. Only for benchmarks that never wait on another thread of lower priority.
+         */
+        bool realtime = false;
+        NoisePolicy policy = NoisePolicy::Warn;
+
+        /**
+         * Where warnings are printed.
+         */
+        std::ostream *warnings = &std::cerr;
+    };
+
+    namespace detail {
+        struct ActiveEnvironment {
+            const Environment *environment = nullptr;
+            bool refused = false;
+        };
+
+        inline ActiveEnvironment &activeEnvironment() {
+            static ActiveEnvironment active;
+            return active;
+        }
+    }
+
+    /**
+     * Prepares the calling thread for benchmarking for the lifetime of the object: pins it, raises its priority,
+     * probes the environment it now runs in, and warns about, or refuses, noisy conditions. Everything is restored on
+     * destruction.
+     *
+     * While it exists, the reports in this library print its environment in their header. Create one per process,
+     * from the thread that runs the benchmarks.
+     */
+    class BenchmarkEnvironment {
+    public:
+        inline explicit BenchmarkEnvironment(const EnvironmentOptions &options = {}) {
+            const std::vector<unsigned> allowed = allowedCores();
+            int core = options.core;
+            if (core < 0 && !allowed.empty()) {
+                const std::vector<unsigned> isolated =
+                        detail::parseCpuList(detail::readFirstLine("/sys/devices/system/cpu/isolated"));
+                const auto usable = std::find_first_of(isolated.begin(), isolated.end(), allowed.begin(), allowed.end());
+                core = static_cast<int>(usable != isolated.end() ? *usable : allowed.back());
+            }
+
+            bool pinned = false;
+            if (options.pin && core >= 0) {
+                m_Affinity.emplace(std::vector<unsigned>{static_cast<unsigned>(core)});
+                pinned = m_Affinity->applied();
+            }
+
+            bool raised = false;
+            if (options.realtime) {
+                m_Realtime.emplace();
+                raised = m_Realtime->applied();
+            } else if (options.raisePriority) {
+                raised = raiseNice();
+            }
+
+            m_Environment = probeEnvironment(pinned ? core : detail::currentCore());
+            m_Environment.pinned = pinned;
+            m_Environment.priorityRaised = raised;
+            m_Warnings = environmentWarnings(m_Environment);
+
+            if (options.policy != NoisePolicy::Ignore && options.warnings != nullptr) {
+                for (const std::string &warning: m_Warnings) {
+                    *options.warnings << "warning: " << warning << '\n';
+                }
+            }
+            m_Refused = options.policy == NoisePolicy::Refuse && !m_Warnings.empty();
+            if (m_Refused && options.warnings != nullptr) {
+                *options.warnings << "refusing to benchmark in a noisy environment\n";
+            }
+
+            m_PreviousActive = detail::activeEnvironment();
+            detail::activeEnvironment() = detail::ActiveEnvironment{&m_Environment, m_Refused};
+        }
+
+        BenchmarkEnvironment(const BenchmarkEnvironment &) = delete;
+        BenchmarkEnvironment &operator=(const BenchmarkEnvironment &) = delete;
+
+        ~BenchmarkEnvironment() {
+            detail::activeEnvironment() = m_PreviousActive;
+#if defined(__linux__)
+            if (m_NiceRaised) {
+                setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), m_PreviousNice);
+            }
+#endif
+        }
+
+        inline const Environment &environment() const { return m_Environment; }
+
+        inline const std::vector<std::string> &warnings() const { return m_Warnings; }
+
+        /**
+         * @return True if the policy is Refuse and the environment is noisy. The library's runners then do nothing,
+         * and a caller timing code of its own should not benchmark either.
+         */
+        inline bool refused() const { return m_Refused; }
+
+    private:
+        inline bool raiseNice() {
+#if defined(__linux__)
+            // On Linux, nice values are per thread when addressed by thread id
+            const auto thread = static_cast<id_t>(syscall(SYS_gettid));
+            errno = 0;
+            const int previous = getpriority(PRIO_PROCESS, thread);
+            if (errno != 0 || setpriority(PRIO_PROCESS, thread, -20) != 0) {
+                return false;
+            }
+            m_PreviousNice = previous;
+            m_NiceRaised = true;
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        std::optional<ScopedAffinity> m_Affinity;
+        std::optional<ScopedRealtimePriority> m_Realtime;
+        bool m_NiceRaised = false;
+        int m_PreviousNice = 0;
+        Environment m_Environment;
+        std::vector<std::string> m_Warnings;
+        bool m_Refused = false;
+        detail::ActiveEnvironment m_PreviousActive;
+    };
+
+    /**
+     * @return The environment of the active BenchmarkEnvironment, or else a probe of the calling thread's
+     * environment taken on first use.
+     */
+    inline const Environment &currentEnvironment() {
+        if (const Environment *active = detail::activeEnvironment().environment) {
+            return *active;
+        }
+        static const Environment probed = probeEnvironment();
+        return probed;
+    }
+
+    /**
+     * @return True while a BenchmarkEnvironment with NoisePolicy::Refuse exists and found the environment noisy.
+     * benchmark, compare, cacheBenchmark, complexitySweep, scalingSweep and time_open_loop then return empty results
+     * without calling the code under test.
+     */
+    inline bool benchmarkingRefused() {
+        return detail::activeEnvironment().refused;
+    }
+
+    /**
+     * @brief Prints the current environment as a one line report header, followed by a second line if benchmarking
+     * was refused.
+     */
+    inline void printEnvironmentHeader(std::ostream &out) {
+        out << "# environment: " << describeEnvironment(currentEnvironment()) << '\n';
+        if (benchmarkingRefused()) {
+            out << "# benchmarking refused: the environment is noisy, so nothing was measured\n";
+        }
+    }
+}
+
+#endif //MCKRUEG_TIMER_ENVIRONMENT_HPP
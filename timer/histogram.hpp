@@ -0,0 +1,236 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_HISTOGRAM_HPP
+#define MCKRUEG_TIMER_HISTOGRAM_HPP
+#include "../timer.hpp"
+#include "environment.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * A log-linear histogram of durations, recorded in whole nanoseconds.
+     *
+     * Values below 256 ns are counted exactly. Above that, every power of two is split into 128 equal buckets, so any
+     * recorded value is reported within 1% of what was recorded, from nanoseconds up to centuries. Recording is a
+     * few integer instructions and never allocates, which makes it suitable for hot paths and jitter measurement.
+     *
+     * @note A Histogram is not thread-safe. Record into one histogram per thread and merge them afterward.
+     */
+    class Histogram {
+    public:
+        static constexpr unsigned subBucketBits = 7;
+        static constexpr std::uint64_t subBuckets = std::uint64_t{1} << subBucketBits;
+        static constexpr std::size_t bucketCount = (64 - subBucketBits + 1) * subBuckets;
+
+        inline Histogram() : m_Counts(bucketCount, 0) {}
+
+        /**
+         * @brief Records a value in nanoseconds.
+         * @param ns The value, in whole nanoseconds.
+         * @param count How many times to record it.
+         */
+        inline void record(std::uint64_t ns, std::uint64_t count = 1) {
+            m_Counts[indexOf(ns)] += count;
+            m_Total += count;
+            m_Sum += static_cast<double>(ns) * static_cast<double>(count);
+            m_Min = std::min(m_Min, ns);
+            m_Max = std::max(m_Max, ns);
+        }
+
+        /**
+         * @brief Records a duration. Negative durations are recorded as zero.
+         */
+        inline void record(Duration duration, std::uint64_t count = 1) {
+            const double value = std::round(duration.count() * 1e9);
+            record(value <= 0.0 ? 0 : static_cast<std::uint64_t>(value), count);
+        }
+
+        /**
+         * @brief Adds every value recorded in another histogram.
+         */
+        inline void merge(const Histogram &other) {
+            for (std::size_t i = 0; i < bucketCount; ++i) {
+                m_Counts[i] += other.m_Counts[i];
+            }
+            m_Total += other.m_Total;
+            m_Sum += other.m_Sum;
+            m_Min = std::min(m_Min, other.m_Min);
+            m_Max = std::max(m_Max, other.m_Max);
+        }
+
+        /**
+         * @brief Discards every recorded value.
+         */
+        inline void reset() {
+            std::fill(m_Counts.begin(), m_Counts.end(), 0);
+            m_Total = 0;
+            m_Sum = 0.0;
+            m_Min = std::numeric_limits<std::uint64_t>::max();
+            m_Max = 0;
+        }
+
+        inline std::uint64_t count() const { return m_Total; }
+
+        inline bool empty() const { return m_Total == 0; }
+
+        inline Duration min() const { return empty() ? Duration(0.0) : fromNanoseconds(static_cast<double>(m_Min)); }
+
+        inline Duration max() const { return fromNanoseconds(static_cast<double>(m_Max)); }
+
+        inline Duration mean() const {
+            return empty() ? Duration(0.0) : fromNanoseconds(m_Sum / static_cast<double>(m_Total));
+        }
+
+        /**
+         * @param q The quantile, from 0 to 1. For example 0.99 for the 99th percentile.
+         * @return The value at the quantile, as the midpoint of its bucket clamped to the recorded range.
+         */
+        inline Duration quantile(double q) const {
+            if (empty()) {
+                return Duration(0.0);
+            }
+            const auto rank = static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(m_Total)));
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucketCount; ++i) {
+                seen += m_Counts[i];
+                if (seen >= std::max<std::uint64_t>(rank, 1)) {
+                    const double middle = (static_cast<double>(lowerBound(i)) + static_cast<double>(upperBound(i))) / 2.0;
+                    return fromNanoseconds(std::clamp(middle, static_cast<double>(m_Min), static_cast<double>(m_Max)));
+                }
+            }
+            return max();
+        }
+
+        /**
+         * @brief Prints the environment header, then the count, min, mean, common percentiles and max, in microseconds.
+         */
+        inline void printSummary(std::ostream &out) const {
+            printEnvironmentHeader(out);
+            out << "count=" << count()
+                << " min=" << microseconds(min()).count()
+                << " mean=" << microseconds(mean()).count()
+                << " p50=" << microseconds(quantile(0.50)).count()
+                << " p90=" << microseconds(quantile(0.90)).count()
+                << " p99=" << microseconds(quantile(0.99)).count()
+                << " p99.9=" << microseconds(quantile(0.999)).count()
+                << " max=" << microseconds(max()).count() << " (us)\n";
+        }
+
+        /**
+         * @brief Prints the environment header, then the distribution as a bar chart over equal width bins between min
+         * and max.
+         * @param bins The number of bins.
+         * @param width The length of the longest bar.
+         */
+        inline void printDistribution(std::ostream &out, unsigned bins = 20, unsigned width = 50) const {
+            printEnvironmentHeader(out);
+            if (empty() || bins == 0) {
+                return;
+            }
+            const double low = static_cast<double>(m_Min);
+            const double binWidth = std::max((static_cast<double>(m_Max) - low) / bins, 1.0);
+
+            std::vector<std::uint64_t> binned(bins, 0);
+            for (std::size_t i = 0; i < bucketCount; ++i) {
+                if (m_Counts[i] != 0) {
+                    const double middle = (static_cast<double>(lowerBound(i)) + static_cast<double>(upperBound(i))) / 2.0;
+                    const auto bin = static_cast<std::size_t>(std::max(middle - low, 0.0) / binWidth);
+                    binned[std::min<std::size_t>(bin, bins - 1)] += m_Counts[i];
+                }
+            }
+
+            const std::uint64_t tallest = *std::max_element(binned.begin(), binned.end());
+            for (unsigned bin = 0; bin < bins; ++bin) {
+                const auto bar = static_cast<unsigned>(static_cast<double>(binned[bin]) * width / static_cast<double>(tallest));
+                out << std::setw(12) << microseconds(fromNanoseconds(low + bin * binWidth)).count() << " us |"
+                    << std::string(bar, '#') << ' ' << binned[bin] << '\n';
+            }
+        }
+
+    private:
+        static inline Duration fromNanoseconds(double ns) {
+            return std::chrono::duration_cast<Duration>(nanoseconds(ns));
+        }
+
+        static inline unsigned highestBit(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+            return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+            unsigned bit = 0;
+            while (value >>= 1) {
+                ++bit;
+            }
+            return bit;
+#endif
+        }
+
+        static inline std::size_t indexOf(std::uint64_t value) {
+            if (value < 2 * subBuckets) {
+                return static_cast<std::size_t>(value);
+            }
+            const unsigned exponent = highestBit(value) - subBucketBits;
+            return static_cast<std::size_t>((exponent + 1) * subBuckets + ((value >> exponent) - subBuckets));
+        }
+
+        static inline std::uint64_t lowerBound(std::size_t index) {
+            if (index < 2 * subBuckets) {
+                return index;
+            }
+            const std::size_t exponent = index / subBuckets - 1;
+            return (index % subBuckets + subBuckets) << exponent;
+        }
+
+        static inline std::uint64_t upperBound(std::size_t index) {
+            if (index < 2 * subBuckets) {
+                return index;
+            }
+            const std::size_t exponent = index / subBuckets - 1;
+            return lowerBound(index) + ((std::uint64_t{1} << exponent) - 1);
+        }
+
+        std::vector<std::uint64_t> m_Counts;
+        std::uint64_t m_Total = 0;
+        double m_Sum = 0.0;
+        std::uint64_t m_Min = std::numeric_limits<std::uint64_t>::max();
+        std::uint64_t m_Max = 0;
+    };
+}
+
+#endif //MCKRUEG_TIMER_HISTOGRAM_HPP
@@ -0,0 +1,512 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_MPI_HPP
+#define MCKRUEG_TIMER_MPI_HPP
+#include "../timer.hpp"
+#include "trace.hpp"
+
+// The MPI extensions need the real MPI types (MPI_Comm, MPI_Request), so unlike the core header there is no weak
+// fallback here. Without BUILD_WITH_MPI this header intentionally declares nothing.
+#ifdef BUILD_WITH_MPI
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * How the end of an MPI timed region is synchronized across the communicator.
+     */
+    enum class MpiEndSync {
+        /**
+         * No synchronization. The global duration is the same as the local duration.
+         */
+        None,
+
+        /**
+         * MPI_Barrier after the region. The global end timestamp is taken once every rank has arrived.
+         */
+        Barrier,
+
+        /**
+         * MPI_Ibarrier after the region. The barrier is posted as soon as the local end timestamp is taken, and
+         * completion is only awaited when the global duration is requested. This lets a rank keep working instead of
+         * blocking, which is cheaper when only the end needs syncing.
+         */
+        NonBlockingBarrier
+    };
+
+    /**
+     * Options controlling barrier synchronization of an MPI timed region.
+     */
+    struct MpiTimeOptions {
+        /**
+         * The communicator to synchronize on. Every rank in it must time the same region.
+         */
+        MPI_Comm communicator = MPI_COMM_WORLD;
+
+        /**
+         * If true, MPI_Barrier is called before the start timestamp so that every rank starts together,
+         * removing per-rank start skew from the measurement.
+         */
+        bool barrierBeforeStart = true;
+
+        /**
+         * How the end of the region is synchronized.
+         */
+        MpiEndSync endSync = MpiEndSync::Barrier;
+    };
+
+    /**
+     * The result of an MPI synchronized measurement.
+     * TimeResult<T>::duration holds the local duration, that is the time this rank spent in the region.
+     *
+     * @tparam T Type of the function result.
+     */
+    template<typename T>
+    struct MpiTimeResult : TimeResult<T> {
+        /**
+         * The globally synchronized duration: from the (optionally barrier aligned) start until every rank in the
+         * communicator has finished the region. Equal to the local duration when MpiEndSync::None is used.
+         */
+        Duration globalDuration;
+    };
+
+    /**
+     * Measures a region on every rank of a communicator, with optional barriers before the start and after the end.
+     *
+     * Unlike the core Timer, this class is usable directly so that work can be overlapped with a non-blocking end
+     * barrier: call stop() when the region ends, do other work, then call globalDuration().
+     *
+     * @note This is a collective operation. Every rank in the communicator must construct, stop and (for the barrier
+     * modes) query the global duration in the same order, or the program will deadlock.
+     */
+    class MpiTimer {
+    public:
+        /**
+         * Starts the timer, calling MPI_Barrier first if requested.
+         * @param options The synchronization options.
+         */
+        inline explicit MpiTimer(MpiTimeOptions options = {}) : m_Options(options) {
+            if (m_Options.barrierBeforeStart) {
+                MPI_Barrier(m_Options.communicator);
+            }
+            m_StartTime = MPI_Wtime();
+        }
+
+        // The pending request may not be duplicated
+        MpiTimer(const MpiTimer &) = delete;
+        MpiTimer &operator=(const MpiTimer &) = delete;
+
+        ~MpiTimer() {
+            // never leave a request dangling, MPI requires it to be completed
+            if (m_Request != MPI_REQUEST_NULL) {
+                MPI_Wait(&m_Request, MPI_STATUS_IGNORE);
+            }
+        }
+
+        /**
+         * Ends the region on this rank. Takes the local end timestamp, then applies the end synchronization.
+         * Calling stop() more than once has no effect.
+         */
+        inline void stop() {
+            if (m_Stopped) {
+                return;
+            }
+            m_Stopped = true;
+            m_LocalEndTime = MPI_Wtime();
+
+            switch (m_Options.endSync) {
+                case MpiEndSync::None:
+                    m_GlobalEndTime = m_LocalEndTime;
+                    m_GlobalKnown = true;
+                    break;
+                case MpiEndSync::Barrier:
+                    MPI_Barrier(m_Options.communicator);
+                    m_GlobalEndTime = MPI_Wtime();
+                    m_GlobalKnown = true;
+                    break;
+                case MpiEndSync::NonBlockingBarrier:
+                    MPI_Ibarrier(m_Options.communicator, &m_Request);
+                    break;
+            }
+        }
+
+        /**
+         * @return The time this rank spent in the region. Stops the timer if it is still running.
+         */
+        inline Duration localDuration() {
+            stop();
+            return Duration(m_LocalEndTime - m_StartTime);
+        }
+
+        /**
+         * @return The time until every rank finished the region. Stops the timer if it is still running, and waits for
+         * the non-blocking barrier if one is pending.
+         * @note For MpiEndSync::NonBlockingBarrier the global end timestamp is taken when completion is observed, so
+         * any work done between stop() and this call that outlasts the slowest rank is included.
+         */
+        inline Duration globalDuration() {
+            stop();
+            if (!m_GlobalKnown) {
+                MPI_Wait(&m_Request, MPI_STATUS_IGNORE);
+                m_GlobalEndTime = MPI_Wtime();
+                m_GlobalKnown = true;
+            }
+            return Duration(m_GlobalEndTime - m_StartTime);
+        }
+
+    private:
+        MpiTimeOptions m_Options;
+        double m_StartTime = 0.0;
+        double m_LocalEndTime = 0.0;
+        double m_GlobalEndTime = 0.0;
+        MPI_Request m_Request = MPI_REQUEST_NULL;
+        bool m_Stopped = false;
+        bool m_GlobalKnown = false;
+    };
+
+    /**
+     * @brief Times a function on every rank of a communicator, returning an MpiTimeResult<T>.
+     *
+     * Behaves like timer::time, but synchronizes the start and end as described by options, and reports both the
+     * local and the globally synchronized duration.
+     *
+     * @note This is a collective operation on options.communicator.
+     * @tparam FuncToTime The type of function to time.
+     * @param toTime The function to time.
+     * @param options The synchronization options.
+     * @return An MpiTimeResult with the local duration, global duration, and the function result if it is non-void.
+     */
+    template<typename FuncToTime>
+    inline MpiTimeResult<std::invoke_result_t<FuncToTime> > time(FuncToTime toTime, const MpiTimeOptions &options) {
+        using ResultType = std::invoke_result_t<FuncToTime>;
+
+        if constexpr (std::is_void_v<ResultType>) {
+            MpiTimeResult<void> result{};
+            MpiTimer timer(options);
+            toTime();
+            result.duration = timer.localDuration();
+            result.globalDuration = timer.globalDuration();
+            return result;
+        } else {
+            MpiTimer timer(options);
+            ResultType functionResult = toTime();
+            Duration local = timer.localDuration();
+            return MpiTimeResult<ResultType>{
+                {static_cast<ResultType &&>(functionResult), local},
+                timer.globalDuration()
+            };
+        }
+    }
+
+    /**
+     * A single estimate of how far this rank's MPI_Wtime is from the reference rank's MPI_Wtime.
+     */
+    struct ClockOffsetEstimate {
+        /**
+         * Seconds to add to a local MPI_Wtime value to place it on the reference rank's timeline.
+         */
+        double offset = 0.0;
+
+        /**
+         * The error bound of the offset in seconds: half of the fastest observed round trip.
+         */
+        double uncertainty = 0.0;
+
+        /**
+         * The local MPI_Wtime at which the estimate was taken. Used to extrapolate drift.
+         */
+        double measuredAt = 0.0;
+    };
+
+    /**
+     * Estimates the offset and drift of every rank's MPI_Wtime against a reference rank, so that timestamps recorded
+     * on different ranks can be merged onto a single timeline.
+     *
+     * The estimate is Cristian style: each rank pings the reference rank, which replies with its own time.
+     * The sample with the fastest round trip is kept, and the reference time is assumed to lie in the middle of it.
+     * A second estimate (see refine()) yields the linear drift between the two clocks.
+     *
+     * If the MPI implementation reports MPI_WTIME_IS_GLOBAL on MPI_COMM_WORLD, no messages are exchanged and the
+     * offset is zero.
+     *
+     * @note The constructor and refine() are collective operations on the communicator.
+     * They must be called before MPI_Finalize.
+     */
+    class MpiClockSync {
+    public:
+        /**
+         * Takes the initial offset estimate.
+         * @param communicator The communicator whose ranks are synchronized.
+         * @param root The reference rank. Its clock defines the merged timeline.
+         * @param rounds The number of ping-pongs per rank. More rounds make a fast round trip more likely.
+         */
+        inline explicit MpiClockSync(MPI_Comm communicator = MPI_COMM_WORLD, int root = 0, int rounds = 32)
+            : m_Communicator(communicator), m_Root(root), m_Rounds(std::max(rounds, 1)) {
+            int *isGlobal = nullptr;
+            int found = 0;
+            MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_WTIME_IS_GLOBAL, &isGlobal, &found);
+            m_WtimeIsGlobal = found && isGlobal != nullptr && *isGlobal != 0;
+
+            m_Initial = estimate();
+            m_Latest = m_Initial;
+        }
+
+        /**
+         * Takes a second estimate, typically just before finalizing, and derives the drift from the initial one.
+         * Timestamps converted afterward are corrected for drift as well as offset.
+         */
+        inline void refine() {
+            m_Latest = estimate();
+            const double elapsed = m_Latest.measuredAt - m_Initial.measuredAt;
+            m_Drift = elapsed > 0.0 ? (m_Latest.offset - m_Initial.offset) / elapsed : 0.0;
+        }
+
+        /**
+         * @param localTime A local MPI_Wtime value.
+         * @return The same instant on the reference rank's timeline.
+         */
+        inline double toGlobal(double localTime) const {
+            return localTime + m_Initial.offset + m_Drift * (localTime - m_Initial.measuredAt);
+        }
+
+        /**
+         * @param localTime A local time point taken from MPI_Wtime.
+         * @return The same instant on the reference rank's timeline.
+         */
+        inline TimePoint toGlobal(TimePoint localTime) const {
+            return TimePoint(Duration(toGlobal(localTime.time_since_epoch().count())));
+        }
+
+        /**
+         * @return The initial offset in seconds.
+         */
+        inline double offset() const { return m_Initial.offset; }
+
+        /**
+         * @return The drift in seconds per second, zero until refine() is called.
+         */
+        inline double drift() const { return m_Drift; }
+
+        /**
+         * @return The uncertainty of converted timestamps in seconds, the worse of the initial and refined estimates.
+         */
+        inline double uncertainty() const { return std::max(m_Initial.uncertainty, m_Latest.uncertainty); }
+
+        /**
+         * @return True if the MPI implementation guarantees synchronized clocks, in which case no correction is applied.
+         */
+        inline bool isWtimeGlobal() const { return m_WtimeIsGlobal; }
+
+        /**
+         * Gathers the latest estimate of every rank to the reference rank, for reporting per rank uncertainty.
+         * @note This is a collective operation on the communicator.
+         * @return On the reference rank, one estimate per rank indexed by rank. Empty on every other rank.
+         */
+        inline std::vector<ClockOffsetEstimate> gatherEstimates() const {
+            int rank = 0;
+            int size = 0;
+            MPI_Comm_rank(m_Communicator, &rank);
+            MPI_Comm_size(m_Communicator, &size);
+
+            ClockOffsetEstimate mine = m_Latest;
+            mine.uncertainty = uncertainty();
+            const double local[3] = {mine.offset, mine.uncertainty, mine.measuredAt};
+
+            std::vector<double> all(rank == m_Root ? static_cast<std::size_t>(size) * 3 : 0);
+            MPI_Gather(local, 3, MPI_DOUBLE, all.data(), 3, MPI_DOUBLE, m_Root, m_Communicator);
+
+            std::vector<ClockOffsetEstimate> estimates;
+            for (std::size_t i = 0; i + 2 < all.size(); i += 3) {
+                estimates.push_back(ClockOffsetEstimate{all[i], all[i + 1], all[i + 2]});
+            }
+            return estimates;
+        }
+
+    private:
+        inline ClockOffsetEstimate estimate() const {
+            ClockOffsetEstimate result;
+            result.measuredAt = MPI_Wtime();
+            if (m_WtimeIsGlobal) {
+                return result;
+            }
+
+            // A private communicator keeps the ping-pong traffic from matching any of the application's messages
+            MPI_Comm communicator;
+            MPI_Comm_dup(m_Communicator, &communicator);
+
+            int rank = 0;
+            int size = 0;
+            MPI_Comm_rank(communicator, &rank);
+            MPI_Comm_size(communicator, &size);
+
+            constexpr int tag = 0;
+            if (rank == m_Root) {
+                // Serve every rank in turn, replying to each ping with the reference time
+                for (int peer = 0; peer < size; ++peer) {
+                    if (peer == m_Root) {
+                        continue;
+                    }
+                    for (int round = 0; round < m_Rounds; ++round) {
+                        char ping = 0;
+                        MPI_Recv(&ping, 1, MPI_CHAR, peer, tag, communicator, MPI_STATUS_IGNORE);
+                        const double referenceTime = MPI_Wtime();
+                        MPI_Send(&referenceTime, 1, MPI_DOUBLE, peer, tag, communicator);
+                    }
+                }
+            } else {
+                double bestRoundTrip = std::numeric_limits<double>::infinity();
+                for (int round = 0; round < m_Rounds; ++round) {
+                    const char ping = 0;
+                    double referenceTime = 0.0;
+                    const double sent = MPI_Wtime();
+                    MPI_Send(&ping, 1, MPI_CHAR, m_Root, tag, communicator);
+                    MPI_Recv(&referenceTime, 1, MPI_DOUBLE, m_Root, tag, communicator, MPI_STATUS_IGNORE);
+                    const double received = MPI_Wtime();
+
+                    // The fastest round trip bounds the reply's position most tightly
+                    const double roundTrip = received - sent;
+                    if (roundTrip < bestRoundTrip) {
+                        bestRoundTrip = roundTrip;
+                        result.offset = referenceTime - (sent + received) / 2.0;
+                        result.uncertainty = roundTrip / 2.0;
+                        result.measuredAt = (sent + received) / 2.0;
+                    }
+                }
+            }
+
+            MPI_Comm_free(&communicator);
+            return result;
+        }
+
+        MPI_Comm m_Communicator;
+        int m_Root;
+        int m_Rounds;
+        bool m_WtimeIsGlobal = false;
+        ClockOffsetEstimate m_Initial;
+        ClockOffsetEstimate m_Latest;
+        double m_Drift = 0.0;
+    };
+
+    /**
+     * Writes the events of every rank into a single merged trace file, readable with readMergedTrace.
+     *
+     * The file holds a header, a per-rank index and then each rank's events. Every rank computes its own offset with
+     * MPI_Exscan and writes its index entry and events with MPI_File_write_at_all, so no rank ever holds more than its
+     * own events and only one file is created regardless of the number of ranks.
+     *
+     * @note This is a collective operation on the communicator.
+     * @param buffer This rank's events.
+     * @param path The file to create or overwrite.
+     * @param communicator The ranks contributing events.
+     * @param clockSync If not null, used to place every timestamp on the reference rank's timeline.
+     * @return True if the file was written on every rank.
+     */
+    inline bool writeMergedTrace(const TraceBuffer &buffer, const std::string &path,
+                                 MPI_Comm communicator = MPI_COMM_WORLD, const MpiClockSync *clockSync = nullptr) {
+        int rank = 0;
+        int size = 0;
+        MPI_Comm_rank(communicator, &rank);
+        MPI_Comm_size(communicator, &size);
+
+        std::vector<TraceEvent> events = buffer.events();
+        for (TraceEvent &event: events) {
+            if (clockSync != nullptr) {
+                event.start = clockSync->toGlobal(event.start);
+                event.end = clockSync->toGlobal(event.end);
+            }
+            event.rank = static_cast<std::uint32_t>(rank);
+        }
+
+        // Where this rank's events start, relative to the first event in the file
+        std::uint64_t count = events.size();
+        std::uint64_t eventsBefore = 0;
+        MPI_Exscan(&count, &eventsBefore, 1, MPI_UINT64_T, MPI_SUM, communicator);
+        if (rank == 0) {
+            eventsBefore = 0; // MPI_Exscan leaves rank 0 undefined
+        }
+
+        const std::uint64_t indexOffset = sizeof(TraceFileHeader);
+        const std::uint64_t dataOffset = indexOffset + static_cast<std::uint64_t>(size) * sizeof(TraceIndexEntry);
+        const TraceIndexEntry entry{dataOffset + eventsBefore * sizeof(TraceEvent), count};
+
+        MPI_File file;
+        if (MPI_File_open(communicator, path.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file) !=
+            MPI_SUCCESS) {
+            return false;
+        }
+        MPI_File_set_size(file, 0);
+
+        // Rank 0's index entry directly follows the header, so it writes both in one piece
+        std::vector<char> indexBytes;
+        MPI_Offset indexWriteAt = static_cast<MPI_Offset>(indexOffset + static_cast<std::uint64_t>(rank) * sizeof(TraceIndexEntry));
+        if (rank == 0) {
+            TraceFileHeader header{};
+            std::memcpy(header.magic, traceFileMagic, sizeof(header.magic));
+            header.version = traceFileVersion;
+            header.rankCount = static_cast<std::uint32_t>(size);
+            header.eventSize = sizeof(TraceEvent);
+            indexBytes.resize(sizeof(header));
+            std::memcpy(indexBytes.data(), &header, sizeof(header));
+            indexWriteAt = 0;
+        }
+        const std::size_t headerBytes = indexBytes.size();
+        indexBytes.resize(headerBytes + sizeof(entry));
+        std::memcpy(indexBytes.data() + headerBytes, &entry, sizeof(entry));
+
+        int ok = MPI_File_write_at_all(file, indexWriteAt, indexBytes.data(), static_cast<int>(indexBytes.size()),
+                                       MPI_BYTE, MPI_STATUS_IGNORE) == MPI_SUCCESS;
+
+        // Events are written as whole records so the element count stays within an int for large buffers
+        MPI_Datatype eventType;
+        MPI_Type_contiguous(static_cast<int>(sizeof(TraceEvent)), MPI_BYTE, &eventType);
+        MPI_Type_commit(&eventType);
+        ok &= MPI_File_write_at_all(file, static_cast<MPI_Offset>(entry.offset), events.data(),
+                                    static_cast<int>(events.size()), eventType, MPI_STATUS_IGNORE) == MPI_SUCCESS;
+        MPI_Type_free(&eventType);
+
+        ok &= MPI_File_close(&file) == MPI_SUCCESS;
+
+        int allOk = 0;
+        MPI_Allreduce(&ok, &allOk, 1, MPI_INT, MPI_LAND, communicator);
+        return allOk != 0;
+    }
+}
+
+#endif // BUILD_WITH_MPI
+
+#endif //MCKRUEG_TIMER_MPI_HPP
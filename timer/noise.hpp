@@ -0,0 +1,265 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_NOISE_HPP
+#define MCKRUEG_TIMER_NOISE_HPP
+#include "../timer.hpp"
+#include "clocks.hpp"
+#include "environment.hpp"
+#include "histogram.hpp"
+#include "platform.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * One interruption seen by a noise probe: a gap between consecutive clock reads above the threshold.
+     */
+    struct NoiseEvent {
+        /**
+         * When the gap began, on the probe's clock backend.
+         */
+        TimePoint at;
+        Duration gap{0.0};
+    };
+
+    /**
+     * What a noise probe saw on one core.
+     */
+    struct CoreNoise {
+        unsigned core = 0;
+
+        /**
+         * True if the probe thread was pinned to the core.
+         */
+        bool pinned = false;
+
+        /**
+         * How long the probe spun.
+         */
+        Duration sampled{0.0};
+        std::uint64_t reads = 0;
+
+        /**
+         * Every gap above the threshold.
+         */
+        Histogram gaps;
+
+        /**
+         * The first gaps above the threshold, with timestamps, up to NoiseOptions::maxEvents.
+         */
+        std::vector<NoiseEvent> events;
+
+        /**
+         * The sum of every gap above the threshold.
+         */
+        Duration totalNoise{0.0};
+
+        /**
+         * Interruptions per second.
+         */
+        inline double frequency() const {
+            return sampled.count() > 0.0 ? static_cast<double>(gaps.count()) / sampled.count() : 0.0;
+        }
+
+        /**
+         * The fraction of the sampled time lost to interruptions.
+         */
+        inline double noiseFraction() const {
+            return sampled.count() > 0.0 ? totalNoise / sampled : 0.0;
+        }
+    };
+
+    /**
+     * Options for a noise probe.
+     */
+    struct NoiseOptions {
+        /**
+         * How long run spins. Ignored by start, which spins until stop.
+         */
+        Duration duration = seconds(1.0);
+
+        /**
+         * Gaps between consecutive reads longer than this count as interruptions.
+         */
+        Duration threshold = microseconds(1.0);
+
+        /**
+         * The cores to probe. Empty probes every core the process may use.
+         */
+        std::vector<unsigned> cores;
+
+        /**
+         * The number of timestamped events kept per core.
+         */
+        std::size_t maxEvents = 4096;
+    };
+
+    /**
+     * Measures the interruptions the machine itself causes, in the style of the kernel's hwlat tracer.
+     *
+     * One thread per core, pinned to it, reads the clock backend in a tight loop. Any gap between consecutive reads
+     * longer than the threshold is time the thread did not run: an interrupt, a preemption, an SMI or a
+     * virtualization exit. Gaps are recorded into a per-core histogram, and the first ones are kept with timestamps
+     * so they can be lined up with a workload's own timeline.
+     *
+     * Use run for a baseline on an idle machine, or start and stop around a workload to see the noise alongside it.
+     * Each probe thread occupies its core completely while it runs.
+     *
+     * @tparam Backend The clock to read. TscClockBackend has the cheapest read, and so the finest detection.
+     */
+    template<typename Backend = SteadyClockBackend>
+    class NoiseProbe {
+    public:
+        inline explicit NoiseProbe(NoiseOptions options = {}) : m_Options(std::move(options)) {
+            if (m_Options.cores.empty()) {
+                m_Options.cores = allowedCores();
+            }
+        }
+
+        NoiseProbe(const NoiseProbe &) = delete;
+        NoiseProbe &operator=(const NoiseProbe &) = delete;
+
+        ~NoiseProbe() { stop(); }
+
+        /**
+         * @brief Starts spinning on every core, and returns immediately.
+         */
+        inline void start() {
+            stop();
+            m_Stopped.store(false, std::memory_order_relaxed);
+            m_Results.assign(m_Options.cores.size(), CoreNoise{});
+            for (std::size_t i = 0; i < m_Options.cores.size(); ++i) {
+                m_Threads.emplace_back([this, i] { probe(m_Options.cores[i], m_Results[i]); });
+            }
+        }
+
+        /**
+         * @brief Stops every probe thread and waits for them.
+         * @return The noise seen on each core.
+         */
+        inline const std::vector<CoreNoise> &stop() {
+            m_Stopped.store(true, std::memory_order_relaxed);
+            for (std::thread &thread: m_Threads) {
+                thread.join();
+            }
+            m_Threads.clear();
+            return m_Results;
+        }
+
+        /**
+         * @brief Spins on every core for NoiseOptions::duration.
+         * @return The noise seen on each core.
+         */
+        inline const std::vector<CoreNoise> &run() {
+            start();
+            std::this_thread::sleep_for(std::chrono::duration_cast<Clock::duration>(m_Options.duration));
+            return stop();
+        }
+
+        inline const std::vector<CoreNoise> &results() const { return m_Results; }
+
+    private:
+        inline void probe(unsigned core, CoreNoise &result) const {
+            result.core = core;
+            result.pinned = pinThisThread(core);
+            result.events.reserve(m_Options.maxEvents);
+
+            const double ticksPerSecond = Backend::ticksPerSecond();
+            const auto threshold = static_cast<std::uint64_t>(m_Options.threshold.count() * ticksPerSecond);
+            const std::uint64_t first = Backend::ticks();
+            std::uint64_t previous = first;
+            std::uint64_t reads = 0;
+            std::uint64_t noiseTicks = 0;
+
+            // The stop flag is only checked every 256 reads, so the common path is two clock reads apart
+            while (true) {
+                for (int i = 0; i < 256; ++i) {
+                    const std::uint64_t current = Backend::ticks();
+                    const std::uint64_t gap = current - previous;
+                    if (gap > threshold) {
+                        const Duration gapDuration(static_cast<double>(gap) / ticksPerSecond);
+                        result.gaps.record(gapDuration);
+                        noiseTicks += gap;
+                        if (result.events.size() < m_Options.maxEvents) {
+                            result.events.push_back(
+                                NoiseEvent{TimePoint(Duration(static_cast<double>(previous) / ticksPerSecond)),
+                                           gapDuration});
+                        }
+                    }
+                    previous = current;
+                }
+                reads += 256;
+                if (m_Stopped.load(std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+
+            result.reads = reads;
+            result.sampled = Duration(static_cast<double>(previous - first) / ticksPerSecond);
+            result.totalNoise = Duration(static_cast<double>(noiseTicks) / ticksPerSecond);
+        }
+
+        NoiseOptions m_Options;
+        std::atomic<bool> m_Stopped{true};
+        std::vector<std::thread> m_Threads;
+        std::vector<CoreNoise> m_Results;
+    };
+
+    /**
+     * @brief Prints the frequency and magnitude of the noise on each core.
+     */
+    inline void printNoiseReport(std::ostream &out, const std::vector<CoreNoise> &results) {
+        printEnvironmentHeader(out);
+        out << std::setw(6) << "core" << std::setw(12) << "sampled (s)" << std::setw(10) << "events"
+            << std::setw(12) << "events/s" << std::setw(12) << "p50 (us)" << std::setw(12) << "p99 (us)"
+            << std::setw(12) << "max (us)" << std::setw(10) << "noise" << '\n';
+        for (const CoreNoise &core: results) {
+            out << std::setw(6) << core.core << std::setw(12) << core.sampled.count()
+                << std::setw(10) << core.gaps.count() << std::setw(12) << core.frequency()
+                << std::setw(12) << microseconds(core.gaps.quantile(0.5)).count()
+                << std::setw(12) << microseconds(core.gaps.quantile(0.99)).count()
+                << std::setw(12) << microseconds(core.gaps.max()).count()
+                << std::setw(9) << core.noiseFraction() * 100.0 << "%"
+                << (core.pinned ? "" : "  (unpinned)") << '\n';
+        }
+    }
+}
+
+#endif //MCKRUEG_TIMER_NOISE_HPP
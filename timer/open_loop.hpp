@@ -0,0 +1,202 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_OPEN_LOOP_HPP
+#define MCKRUEG_TIMER_OPEN_LOOP_HPP
+#include "../timer.hpp"
+#include "clocks.hpp"
+#include "environment.hpp"
+#include "histogram.hpp"
+#include "sleep.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <random>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * How the intended start times of an open-loop run are spaced.
+     */
+    enum class ArrivalSchedule {
+        /**
+         * Exactly one period of 1 / rate between requests.
+         */
+        Constant,
+
+        /**
+         * Exponentially distributed gaps with mean 1 / rate, as from many independent clients.
+         */
+        Poisson
+    };
+
+    /**
+     * Options for time_open_loop.
+     */
+    struct OpenLoopOptions {
+        /**
+         * The target rate, in requests per second. A rate that is not positive issues no requests.
+         */
+        double rate = 1000.0;
+
+        /**
+         * The number of requests to issue.
+         */
+        std::uint64_t requests = 10000;
+        ArrivalSchedule schedule = ArrivalSchedule::Constant;
+
+        /**
+         * The seed of the Poisson schedule, so runs can be repeated exactly.
+         */
+        std::uint64_t seed = 1;
+    };
+
+    /**
+     * The latencies of an open-loop run.
+     */
+    struct OpenLoopResult {
+        /**
+         * Latency measured from each request's intended start. Includes the time it spent waiting behind a stall.
+         */
+        Histogram corrected;
+
+        /**
+         * Latency measured from when each request actually started, as a closed-loop timer would see it.
+         */
+        Histogram uncorrected;
+
+        /**
+         * From the first intended start until the last request completed.
+         */
+        Duration elapsed{0.0};
+
+        /**
+         * Completed requests per second.
+         */
+        double achievedRate = 0.0;
+
+        /**
+         * The furthest any request started behind its intended start.
+         */
+        Duration maxLag{0.0};
+    };
+
+    /**
+     * @brief Builds the intended start times of an open-loop run, as offsets from its start.
+     * @return One offset per request, or none if the rate is not positive and finite.
+     */
+    inline std::vector<Duration> arrivalOffsets(const OpenLoopOptions &options) {
+        std::vector<Duration> offsets;
+        if (!(options.rate > 0.0) || !std::isfinite(options.rate)) {
+            return offsets;
+        }
+        offsets.reserve(options.requests);
+
+        const double period = 1.0 / options.rate;
+        std::mt19937_64 random(options.seed);
+        std::exponential_distribution<double> gap(options.rate);
+
+        double offset = 0.0;
+        for (std::uint64_t i = 0; i < options.requests; ++i) {
+            offsets.emplace_back(offset);
+            offset += options.schedule == ArrivalSchedule::Poisson ? gap(random) : period;
+        }
+        return offsets;
+    }
+
+    /**
+     * @brief Issues calls at a target rate on a precomputed schedule, and measures their latency without coordinated
+     * omission.
+     *
+     * Timing calls back to back hides queueing: when the system stalls, the requests that would have arrived during
+     * the stall are simply never sent, so the stall shows up as one slow sample. Here every request has an intended
+     * start time fixed before the run. If the previous call is still running when a request is due, the request starts
+     * as soon as it can, and its corrected latency counts from when it was due.
+     *
+     * @param toTime The call to issue. Runs on the calling thread.
+     * @param options The rate, request count and arrival schedule.
+     * @return Both histograms, with the achieved rate and the largest lag behind schedule.
+     */
+    template<typename FuncToTime>
+    inline OpenLoopResult time_open_loop(FuncToTime &&toTime, const OpenLoopOptions &options = {}) {
+        const std::vector<Duration> offsets = benchmarkingRefused() ? std::vector<Duration>{} : arrivalOffsets(options);
+        OpenLoopResult result;
+        if (offsets.empty()) {
+            return result;
+        }
+
+        const TimePoint start = SteadyClockBackend::now();
+        TimePoint finished = start;
+        for (const Duration offset: offsets) {
+            const TimePoint intended = start + offset;
+            if (SteadyClockBackend::now() < intended) {
+                sleep_until_precise(intended);
+            }
+
+            const TimePoint actual = SteadyClockBackend::now();
+            toTime();
+            finished = SteadyClockBackend::now();
+
+            result.corrected.record(finished - intended);
+            result.uncorrected.record(finished - actual);
+            result.maxLag = std::max(result.maxLag, actual - intended);
+        }
+
+        result.elapsed = finished - start;
+        result.achievedRate = static_cast<double>(offsets.size()) / result.elapsed.count();
+        return result;
+    }
+
+    /**
+     * @brief Prints the corrected and uncorrected percentiles side by side, in microseconds.
+     */
+    inline void printOpenLoopReport(std::ostream &out, const OpenLoopResult &result) {
+        printEnvironmentHeader(out);
+        out << "achieved " << result.achievedRate << " requests/s, max lag "
+            << microseconds(result.maxLag).count() << " us\n"
+            << std::setw(10) << "" << std::setw(18) << "uncorrected (us)" << std::setw(18) << "corrected (us)" << '\n';
+
+        const auto row = [&](const char *label, Duration uncorrected, Duration corrected) {
+            out << std::setw(10) << label << std::setw(18) << microseconds(uncorrected).count()
+                << std::setw(18) << microseconds(corrected).count() << '\n';
+        };
+        row("mean", result.uncorrected.mean(), result.corrected.mean());
+        for (const auto &[label, q]: {std::pair{"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}, {"p99.9", 0.999}}) {
+            row(label, result.uncorrected.quantile(q), result.corrected.quantile(q));
+        }
+        row("max", result.uncorrected.max(), result.corrected.max());
+    }
+}
+
+#endif //MCKRUEG_TIMER_OPEN_LOOP_HPP
@@ -0,0 +1,154 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_PARALLEL_HPP
+#define MCKRUEG_TIMER_PARALLEL_HPP
+#include "../timer.hpp"
+#include "platform.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * The result of timing a callable on several threads at once.
+     */
+    struct ParallelTimeResult {
+        /**
+         * The duration of the callable on each thread, indexed by thread.
+         */
+        std::vector<Duration> threadDurations;
+
+        /**
+         * From the synchronized release of every thread until the last one finished.
+         */
+        Duration wallDuration{0.0};
+
+        /**
+         * Completed calls per second across the group: the thread count divided by the wall duration.
+         */
+        double throughput = 0.0;
+    };
+
+    namespace detail {
+        /**
+         * Calls a parallel callable with the thread index if it accepts one, and without arguments otherwise.
+         */
+        template<typename FuncToTime>
+        inline void invokeWithIndex(FuncToTime &toTime, unsigned index) {
+            if constexpr (std::is_invocable_v<FuncToTime &, unsigned>) {
+                toTime(index);
+            } else {
+                toTime();
+            }
+        }
+    }
+
+    /**
+     * @brief Times a callable on threadCount workers of a pool, all entering it at the same instant.
+     *
+     * The workers are handed the task and wait at a spin barrier. Once every worker is waiting, they are released
+     * together, so dispatch is excluded from every measurement. Each worker times its own call, and the group is timed
+     * from release until the last worker finishes.
+     *
+     * @tparam FuncToTime A callable taking either no arguments or the thread index as an unsigned. Any return value is
+     * discarded. It is called concurrently, so it must be safe to do so.
+     * @param pool The pool to run on. Reusing one pool across measurements avoids thread creation entirely.
+     * @param threadCount The number of workers to use, at most pool.size().
+     * @param toTime The function to time.
+     * @return The per-thread durations, the wall duration of the group and its throughput.
+     */
+    template<typename FuncToTime>
+    inline ParallelTimeResult time_parallel(BenchmarkThreadPool &pool, unsigned threadCount, FuncToTime toTime) {
+        ParallelTimeResult result;
+        threadCount = std::min(threadCount, pool.size());
+        if (threadCount == 0) {
+            return result;
+        }
+
+        std::vector<TimePoint> endTimes(threadCount);
+        result.threadDurations.resize(threadCount);
+
+        std::atomic<unsigned> waiting{0};
+        std::atomic<bool> released{false};
+
+        auto task = [&](unsigned index) {
+            waiting.fetch_add(1, std::memory_order_acq_rel);
+            spinUntil([&] { return released.load(std::memory_order_acquire); });
+
+            const TimePoint start = now();
+            detail::invokeWithIndex(toTime, index);
+            endTimes[index] = now();
+            result.threadDurations[index] = endTimes[index] - start;
+        };
+        for (unsigned worker = 0; worker < threadCount; ++worker) {
+            pool.submit(worker, task);
+        }
+
+        spinUntil([&] { return waiting.load(std::memory_order_acquire) == threadCount; });
+        const TimePoint releaseTime = now();
+        released.store(true, std::memory_order_release);
+        pool.waitAll();
+
+        result.wallDuration = *std::max_element(endTimes.begin(), endTimes.end()) - releaseTime;
+        result.throughput = result.wallDuration.count() > 0.0
+                                ? static_cast<double>(threadCount) / result.wallDuration.count()
+                                : 0.0;
+        return result;
+    }
+
+    /**
+     * @brief Times a callable on threadCount threads that all enter it at the same instant.
+     *
+     * Starts a temporary BenchmarkThreadPool of threadCount pinned workers. Thread startup is excluded from the
+     * measurement, but when timing repeatedly, keep a pool and use the overload taking it instead.
+     *
+     * @tparam FuncToTime A callable taking either no arguments or the thread index as an unsigned. Any return value is
+     * discarded. It is called concurrently, so it must be safe to do so.
+     * @param threadCount The number of threads.
+     * @param toTime The function to time.
+     * @return The per-thread durations, the wall duration of the group and its throughput.
+     */
+    template<typename FuncToTime>
+    inline ParallelTimeResult time_parallel(unsigned threadCount, FuncToTime toTime) {
+        if (threadCount == 0) {
+            return {};
+        }
+        BenchmarkThreadPool pool(threadCount);
+        return time_parallel(pool, threadCount, std::move(toTime));
+    }
+}
+
+#endif //MCKRUEG_TIMER_PARALLEL_HPP
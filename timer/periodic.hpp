@@ -0,0 +1,225 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_PERIODIC_HPP
+#define MCKRUEG_TIMER_PERIODIC_HPP
+#include "../timer.hpp"
+#include "clocks.hpp"
+#include "histogram.hpp"
+#include "platform.hpp"
+#include "sleep.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <type_traits>
+
+namespace timer {
+
+    /**
+     * What a PeriodicExecutor does when a run of the task ends after one or more later deadlines have passed.
+     */
+    enum class MissedPeriodPolicy {
+        /**
+         * Run every missed period, back to back, until the executor is on schedule again.
+         */
+        CatchUp,
+
+        /**
+         * Drop the missed periods and resume at the next deadline still in the future.
+         */
+        Skip
+    };
+
+    /**
+     * Options for a PeriodicExecutor.
+     */
+    struct PeriodicOptions {
+        MissedPeriodPolicy missedPeriods = MissedPeriodPolicy::Skip;
+
+        /**
+         * Wait for each deadline with sleep_until_precise. Otherwise use std::this_thread::sleep_until.
+         */
+        bool preciseSleep = true;
+
+        /**
+         * Run the loop under SCHED_FIFO when the process is permitted to.
+         */
+        bool realtime = false;
+
+        /**
+         * The SCHED_FIFO priority. Zero is the lowest real-time priority.
+         */
+        int realtimePriority = 0;
+    };
+
+    /**
+     * What happened during PeriodicExecutor::run.
+     */
+    struct PeriodicStats {
+        /**
+         * The number of times the task ran.
+         */
+        std::uint64_t executed = 0;
+
+        /**
+         * The number of periods dropped under MissedPeriodPolicy::Skip.
+         */
+        std::uint64_t skipped = 0;
+
+        /**
+         * The number of runs that ended after the next deadline.
+         */
+        std::uint64_t overruns = 0;
+
+        /**
+         * How late each run started relative to its scheduled deadline.
+         */
+        Histogram jitter;
+
+        /**
+         * True if the loop ran under SCHED_FIFO.
+         */
+        bool realtime = false;
+    };
+
+    /**
+     * Runs a task at a fixed rate without drift.
+     *
+     * Deadline n is computed as start + n * period, never as the previous wake-up plus a period, so lateness in one
+     * period does not shift any later deadline. How late each run started is recorded in a jitter histogram.
+     *
+     * The task is called with the index of its period as a std::uint64_t, or with no arguments. If it returns bool,
+     * returning false stops the executor.
+     */
+    class PeriodicExecutor {
+    public:
+        /**
+         * @param period The time between deadlines. It must be positive: shorter periods, including zero, negative and
+         * NaN ones, are raised to one nanosecond.
+         * @param options The missed period policy and how to wait.
+         */
+        inline explicit PeriodicExecutor(Duration period, PeriodicOptions options = {})
+            : m_Period(period > minimumPeriod ? period : minimumPeriod), m_Options(options) {}
+
+        /**
+         * @brief Runs the task on the calling thread until the given number of periods has elapsed or stop is called.
+         * @param task The task to run once per period.
+         * @param periods The number of periods to schedule, including skipped ones.
+         * @param start The first deadline, as a steady clock time point. Defaults to now.
+         * @return The run counts and the jitter histogram.
+         */
+        template<typename Task>
+        inline PeriodicStats run(Task &&task, std::uint64_t periods = std::numeric_limits<std::uint64_t>::max(),
+                                 TimePoint start = SteadyClockBackend::now()) {
+            m_Stopped.store(false, std::memory_order_relaxed);
+            std::optional<ScopedRealtimePriority> realtime;
+            if (m_Options.realtime) {
+                realtime.emplace(m_Options.realtimePriority);
+            }
+
+            PeriodicStats stats;
+            stats.realtime = realtime && realtime->applied();
+
+            std::uint64_t index = 0;
+            while (index < periods && !m_Stopped.load(std::memory_order_relaxed)) {
+                const TimePoint deadline = deadlineOf(start, index);
+                if (m_Options.preciseSleep) {
+                    sleep_until_precise(deadline);
+                } else {
+                    std::this_thread::sleep_until(
+                        Clock::time_point(std::chrono::duration_cast<Clock::duration>(deadline.time_since_epoch())));
+                }
+                stats.jitter.record(SteadyClockBackend::now() - deadline);
+
+                ++stats.executed;
+                if (!invoke(task, index)) {
+                    break;
+                }
+
+                const TimePoint finished = SteadyClockBackend::now();
+                std::uint64_t next = index + 1;
+                if (finished > deadlineOf(start, next)) {
+                    ++stats.overruns;
+                    if (m_Options.missedPeriods == MissedPeriodPolicy::Skip) {
+                        // The first deadline after finishing, found from the elapsed time rather than by stepping
+                        const auto elapsedPeriods = static_cast<std::uint64_t>(std::floor((finished - start) / m_Period));
+                        next = std::min(std::max(next, elapsedPeriods + 1), periods);
+                        stats.skipped += next - index - 1;
+                    }
+                }
+                index = next;
+            }
+            return stats;
+        }
+
+        /**
+         * @brief Makes run return before its next period. May be called from any thread, including from the task.
+         */
+        inline void stop() { m_Stopped.store(true, std::memory_order_relaxed); }
+
+        inline Duration period() const { return m_Period; }
+
+    private:
+        static constexpr Duration minimumPeriod{1e-9};
+
+        inline TimePoint deadlineOf(TimePoint start, std::uint64_t index) const {
+            return start + m_Period * static_cast<double>(index);
+        }
+
+        template<typename Task>
+        static inline bool invoke(Task &task, std::uint64_t index) {
+            if constexpr (std::is_invocable_v<Task &, std::uint64_t>) {
+                if constexpr (std::is_same_v<std::invoke_result_t<Task &, std::uint64_t>, bool>) {
+                    return task(index);
+                } else {
+                    task(index);
+                    return true;
+                }
+            } else {
+                if constexpr (std::is_same_v<std::invoke_result_t<Task &>, bool>) {
+                    return task();
+                } else {
+                    task();
+                    return true;
+                }
+            }
+        }
+
+        Duration m_Period;
+        PeriodicOptions m_Options;
+        std::atomic<bool> m_Stopped{false};
+    };
+}
+
+#endif //MCKRUEG_TIMER_PERIODIC_HPP
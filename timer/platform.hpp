@@ -0,0 +1,230 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_PLATFORM_HPP
+#define MCKRUEG_TIMER_PLATFORM_HPP
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace timer {
+
+    /**
+     * Platform helpers for controlling where benchmark threads run.
+     * Thread placement is only implemented on Linux. Elsewhere the functions report failure and do nothing, so callers
+     * degrade to unpinned measurements.
+     */
+
+    /**
+     * @return The logical cores the calling thread may run on, in ascending order. On platforms without affinity
+     * support, every core reported by std::thread::hardware_concurrency.
+     */
+    inline std::vector<unsigned> allowedCores() {
+        std::vector<unsigned> cores;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (unsigned core = 0; core < CPU_SETSIZE; ++core) {
+                if (CPU_ISSET(core, &set)) {
+                    cores.push_back(core);
+                }
+            }
+            return cores;
+        }
+#endif
+        const unsigned count = std::max(std::thread::hardware_concurrency(), 1u);
+        for (unsigned core = 0; core < count; ++core) {
+            cores.push_back(core);
+        }
+        return cores;
+    }
+
+    /**
+     * @brief Restricts the calling thread to a set of cores.
+     * Threads created afterward by the calling thread inherit the restriction.
+     * @param cores The logical cores to allow. Must not be empty.
+     * @return True if the affinity was applied.
+     */
+    inline bool restrictThisThread(const std::vector<unsigned> &cores) {
+#if defined(__linux__)
+        if (cores.empty()) {
+            return false;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (unsigned core: cores) {
+            if (core < CPU_SETSIZE) {
+                CPU_SET(core, &set);
+            }
+        }
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void) cores;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Pins the calling thread to a single core.
+     * @param core The logical core.
+     * @return True if the thread was pinned.
+     */
+    inline bool pinThisThread(unsigned core) {
+        return restrictThisThread(std::vector<unsigned>{core});
+    }
+
+    /**
+     * @brief Tells the CPU the caller is in a spin-wait loop.
+     * This is pause on x86 and yield on AArch64. It saves power and avoids the memory order mis-speculation penalty
+     * on loop exit, and yields pipeline resources to an SMT sibling.
+     */
+    inline void cpuRelax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    /**
+     * @brief Spins until a predicate holds.
+     * Spins with cpuRelax for up to spinLimit checks, then also yields the thread on every check, so that waiting on
+     * an oversubscribed machine still makes progress.
+     * @param predicate The condition to wait for.
+     * @param spinLimit The number of checks before yielding.
+     */
+    template<typename Predicate>
+    inline void spinUntil(Predicate &&predicate, unsigned spinLimit = 1u << 14) {
+        for (unsigned spins = 0; !predicate(); ++spins) {
+            if (spins < spinLimit) {
+                cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * Restricts the calling thread to a set of cores for the lifetime of the object, then restores its previous
+     * affinity.
+     */
+    class ScopedAffinity {
+    public:
+        inline explicit ScopedAffinity(const std::vector<unsigned> &cores)
+            : m_Previous(allowedCores()), m_Applied(restrictThisThread(cores)) {}
+
+        ScopedAffinity(const ScopedAffinity &) = delete;
+        ScopedAffinity &operator=(const ScopedAffinity &) = delete;
+
+        ~ScopedAffinity() {
+            if (m_Applied) {
+                restrictThisThread(m_Previous);
+            }
+        }
+
+        /**
+         * @return True if the restriction is in effect.
+         */
+        inline bool applied() const { return m_Applied; }
+
+    private:
+        std::vector<unsigned> m_Previous;
+        bool m_Applied;
+    };
+
+    /**
+     * Runs the calling thread under the SCHED_FIFO real-time policy for the lifetime of the object, then restores its
+     * previous policy and priority.
+     * Real-time scheduling needs CAP_SYS_NICE or an RLIMIT_RTPRIO allowance. Without permission, or off Linux, nothing
+     * changes and applied() is false.
+     */
+    class ScopedRealtimePriority {
+    public:
+        /**
+         * @param priority The SCHED_FIFO priority, clamped to the valid range. Zero requests the lowest one, which
+         * still preempts every normal thread.
+         */
+        inline explicit ScopedRealtimePriority(int priority = 0) {
+#if defined(__linux__)
+            if (pthread_getschedparam(pthread_self(), &m_PreviousPolicy, &m_PreviousParam) != 0) {
+                return;
+            }
+            sched_param param{};
+            param.sched_priority = std::clamp(priority, sched_get_priority_min(SCHED_FIFO),
+                                              sched_get_priority_max(SCHED_FIFO));
+            m_Applied = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#else
+            (void) priority;
+#endif
+        }
+
+        ScopedRealtimePriority(const ScopedRealtimePriority &) = delete;
+        ScopedRealtimePriority &operator=(const ScopedRealtimePriority &) = delete;
+
+        ~ScopedRealtimePriority() {
+#if defined(__linux__)
+            if (m_Applied) {
+                pthread_setschedparam(pthread_self(), m_PreviousPolicy, &m_PreviousParam);
+            }
+#endif
+        }
+
+        /**
+         * @return True if the thread is running under SCHED_FIFO.
+         */
+        inline bool applied() const { return m_Applied; }
+
+    private:
+#if defined(__linux__)
+        int m_PreviousPolicy = SCHED_OTHER;
+        sched_param m_PreviousParam{};
+#endif
+        bool m_Applied = false;
+    };
+}
+
+#endif //MCKRUEG_TIMER_PLATFORM_HPP
@@ -0,0 +1,135 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_RATE_LIMITER_HPP
+#define MCKRUEG_TIMER_RATE_LIMITER_HPP
+#include "../timer.hpp"
+#include "clocks.hpp"
+#include "sleep.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+namespace timer {
+
+    /**
+     * A lock-free rate limiter using the generic cell rate algorithm (GCRA), the token bucket expressed as a single
+     * timestamp.
+     *
+     * The only state is the theoretical arrival time (TAT): the tick at which the bucket would be full again. Taking n
+     * tokens moves it n emission intervals later, and is allowed as long as it stays within the burst window of now.
+     * An acquire is therefore one load and one compare-and-swap on one cache line, and only retries when another
+     * thread changed the TAT in between.
+     *
+     * @tparam Backend The clock backend to read. TscClockBackend makes the time read far cheaper than the OS clocks.
+     * @note Rates are held in whole ticks per token. With SteadyClockBackend the interval is rounded to the nearest
+     * nanosecond, which only matters near a billion tokens per second.
+     */
+    template<typename Backend = SteadyClockBackend>
+    class RateLimiter {
+    public:
+        /**
+         * @param tokensPerSecond The sustained rate.
+         * @param burst The number of tokens that may be taken at once after a quiet period. At least one.
+         */
+        inline explicit RateLimiter(double tokensPerSecond, double burst = 1.0)
+            : m_Interval(std::max<std::uint64_t>(
+                  static_cast<std::uint64_t>(std::llround(Backend::ticksPerSecond() / tokensPerSecond)), 1)),
+              m_Window(static_cast<std::uint64_t>(std::llround(std::max(burst, 1.0) * static_cast<double>(m_Interval)))),
+              m_Tat(Backend::ticks()) {}
+
+        RateLimiter(const RateLimiter &) = delete;
+        RateLimiter &operator=(const RateLimiter &) = delete;
+
+        /**
+         * @brief Takes tokens if they are available, without waiting.
+         * @param tokens The number of tokens to take at once. More than the burst never succeeds.
+         * @return True if the tokens were taken.
+         */
+        inline bool tryAcquire(std::uint64_t tokens = 1) {
+            const std::uint64_t current = Backend::ticks();
+            const std::uint64_t cost = tokens * m_Interval;
+            std::uint64_t tat = m_Tat.load(std::memory_order_relaxed);
+            while (true) {
+                const std::uint64_t next = std::max(tat, current) + cost;
+                if (next - current > m_Window) {
+                    return false;
+                }
+                if (m_Tat.compare_exchange_weak(tat, next, std::memory_order_relaxed, std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+        }
+
+        /**
+         * @brief Takes tokens, waiting until they become available.
+         * The tokens are reserved with a single atomic add, so waiting callers are served in the order they arrived.
+         * @param tokens The number of tokens to take at once. May exceed the burst, in which case the wait covers
+         * the difference.
+         * @return How long the call waited.
+         */
+        inline Duration acquire(std::uint64_t tokens = 1) {
+            const std::uint64_t current = Backend::ticks();
+            const std::uint64_t cost = tokens * m_Interval;
+
+            // Bring an idle bucket's TAT forward to now first, so the reservation does not draw on unused time
+            std::uint64_t tat = m_Tat.load(std::memory_order_relaxed);
+            while (tat < current && !m_Tat.compare_exchange_weak(tat, current, std::memory_order_relaxed)) {
+            }
+
+            const std::uint64_t next = m_Tat.fetch_add(cost, std::memory_order_relaxed) + cost;
+            if (next - current <= m_Window) {
+                return Duration(0.0);
+            }
+            const Duration wait(static_cast<double>(next - current - m_Window) / Backend::ticksPerSecond());
+            sleep_for_precise(wait);
+            return wait;
+        }
+
+        /**
+         * @return The sustained rate in tokens per second, after rounding the interval to whole ticks.
+         */
+        inline double rate() const { return Backend::ticksPerSecond() / static_cast<double>(m_Interval); }
+
+        /**
+         * @return The largest number of tokens tryAcquire can grant at once.
+         */
+        inline double burst() const { return static_cast<double>(m_Window) / static_cast<double>(m_Interval); }
+
+    private:
+        const std::uint64_t m_Interval;
+        const std::uint64_t m_Window;
+        alignas(64) std::atomic<std::uint64_t> m_Tat;
+    };
+}
+
+#endif //MCKRUEG_TIMER_RATE_LIMITER_HPP
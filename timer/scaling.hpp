@@ -0,0 +1,210 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_SCALING_HPP
+#define MCKRUEG_TIMER_SCALING_HPP
+#include "../timer.hpp"
+#include "benchmark.hpp"
+#include "environment.hpp"
+#include "platform.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * Options for a parallel scaling sweep.
+     */
+    struct ScalingOptions {
+        /**
+         * The largest thread count to run. Zero means std::thread::hardware_concurrency.
+         */
+        unsigned maxThreads = 0;
+
+        /**
+         * The warmup and timed runs at each thread count.
+         */
+        BenchmarkOptions benchmark;
+
+        /**
+         * If true, the run with p threads is restricted to the first p cores the process may use. Threads the workload
+         * creates inherit the restriction, so the same cores are used in the same order on every run.
+         */
+        bool pinThreads = true;
+    };
+
+    /**
+     * The measurements at one thread count.
+     */
+    struct ScalingPoint {
+        unsigned threads = 0;
+        SampleStats stats;
+
+        /**
+         * T(1) / T(p), using median times.
+         */
+        double speedup = 0.0;
+
+        /**
+         * speedup / p.
+         */
+        double efficiency = 0.0;
+
+        /**
+         * The Karp-Flatt experimentally determined serial fraction, (1/speedup - 1/p) / (1 - 1/p).
+         * A value that grows with p points at parallel overhead rather than inherently serial work.
+         * Not defined for one thread, where it is NaN.
+         */
+        double serialFraction = std::numeric_limits<double>::quiet_NaN();
+
+        /**
+         * True if the run was restricted to its cores.
+         */
+        bool pinned = false;
+
+        /**
+         * The throughput, if options.benchmark gave a byte or item count per run.
+         */
+        Throughput throughput;
+    };
+
+    /**
+     * The result of a scaling sweep, one point per thread count in ascending order.
+     */
+    struct ScalingResult {
+        std::vector<ScalingPoint> points;
+    };
+
+    /**
+     * @brief Runs a workload at every thread count from 1 to options.maxThreads and computes its scaling.
+     * @tparam Workload A callable taking the thread count as an unsigned. Its return value is discarded.
+     * @param workload The parallel workload. It must create its threads, or size its pool, inside the call.
+     * @param options The sweep options.
+     * @return Timing, speedup, efficiency and serial fraction at every thread count.
+     */
+    template<typename Workload>
+    inline ScalingResult scalingSweep(Workload &&workload, const ScalingOptions &options = {}) {
+        if (benchmarkingRefused()) {
+            return ScalingResult{};
+        }
+        const unsigned maxThreads = options.maxThreads > 0
+                                        ? options.maxThreads
+                                        : std::max(std::thread::hardware_concurrency(), 1u);
+        const std::vector<unsigned> cores = allowedCores();
+
+        ScalingResult result;
+        for (unsigned threads = 1; threads <= maxThreads; ++threads) {
+            ScalingPoint point;
+            point.threads = threads;
+
+            {
+                // Oversubscribed runs share every allowed core
+                const std::size_t coreCount = std::min<std::size_t>(threads, cores.size());
+                const std::vector<unsigned> used(cores.begin(), cores.begin() + static_cast<std::ptrdiff_t>(coreCount));
+                ScopedAffinity affinity(options.pinThreads ? used : cores);
+                point.pinned = options.pinThreads && affinity.applied();
+
+                const BenchmarkResult measured = benchmark([&workload, threads] { workload(threads); }, options.benchmark);
+                point.stats = measured.stats;
+                point.throughput = measured.throughput;
+            }
+
+            const double baseline = result.points.empty()
+                                        ? point.stats.median.count()
+                                        : result.points.front().stats.median.count();
+            const double p = static_cast<double>(threads);
+            point.speedup = point.stats.median.count() > 0.0 ? baseline / point.stats.median.count() : 0.0;
+            point.efficiency = point.speedup / p;
+            if (threads > 1 && point.speedup > 0.0) {
+                point.serialFraction = (1.0 / point.speedup - 1.0 / p) / (1.0 - 1.0 / p);
+            }
+
+            result.points.push_back(point);
+        }
+        return result;
+    }
+
+    /**
+     * Prints a scaling sweep as an aligned table, with times in milliseconds, and throughput when it was measured.
+     */
+    inline void printScalingTable(std::ostream &out, const ScalingResult &result) {
+        printEnvironmentHeader(out);
+        const bool hasThroughput = std::any_of(result.points.begin(), result.points.end(),
+                                               [](const ScalingPoint &point) { return !point.throughput.empty(); });
+        out << std::setw(8) << "threads" << std::setw(14) << "median (ms)" << std::setw(12) << "mad (ms)"
+            << std::setw(10) << "speedup" << std::setw(12) << "efficiency" << std::setw(12) << "karp-flatt";
+        if (hasThroughput) {
+            out << "  throughput";
+        }
+        out << '\n';
+        for (const ScalingPoint &point: result.points) {
+            out << std::setw(8) << point.threads
+                << std::setw(14) << milliseconds(point.stats.median).count()
+                << std::setw(12) << milliseconds(point.stats.mad).count()
+                << std::setw(10) << point.speedup
+                << std::setw(12) << point.efficiency;
+            if (std::isnan(point.serialFraction)) {
+                out << std::setw(12) << "-";
+            } else {
+                out << std::setw(12) << point.serialFraction;
+            }
+            if (hasThroughput) {
+                out << "  " << formatThroughput(point.throughput);
+            }
+            out << '\n';
+        }
+    }
+
+    /**
+     * Writes a scaling sweep as CSV, with times in seconds and rates per second. The serial fraction is empty for one
+     * thread, and the rates are zero when no byte or item count was given.
+     */
+    inline void writeScalingCsv(std::ostream &out, const ScalingResult &result) {
+        out << "threads,median_s,mad_s,min_s,speedup,efficiency,karp_flatt,pinned,bytes_per_s,items_per_s\n";
+        for (const ScalingPoint &point: result.points) {
+            out << point.threads << ',' << point.stats.median.count() << ',' << point.stats.mad.count() << ','
+                << point.stats.min.count() << ',' << point.speedup << ',' << point.efficiency << ',';
+            if (!std::isnan(point.serialFraction)) {
+                out << point.serialFraction;
+            }
+            out << ',' << (point.pinned ? 1 : 0) << ',' << point.throughput.bytesPerSecond << ','
+                << point.throughput.itemsPerSecond << '\n';
+        }
+    }
+}
+
+#endif //MCKRUEG_TIMER_SCALING_HPP
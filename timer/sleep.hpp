@@ -0,0 +1,180 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_SLEEP_HPP
+#define MCKRUEG_TIMER_SLEEP_HPP
+#include "../timer.hpp"
+#include "clocks.hpp"
+#include "histogram.hpp"
+#include "platform.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+namespace timer {
+
+    /**
+     * Options for a PreciseSleeper.
+     */
+    struct PreciseSleepOptions {
+        /**
+         * The spin threshold used before any oversleep has been measured.
+         */
+        Duration initialThreshold = microseconds(200.0);
+
+        /**
+         * The threshold never adapts below this, so that a run of lucky wake-ups does not leave nothing to spin on.
+         */
+        Duration minThreshold = microseconds(5.0);
+
+        /**
+         * The threshold never adapts above this, so that one descheduling does not turn every sleep into a spin.
+         */
+        Duration maxThreshold = milliseconds(5.0);
+
+        /**
+         * The threshold is this quantile of the measured oversleeps. Sleeps that oversleep past it are late.
+         */
+        double quantile = 0.99;
+
+        /**
+         * After the first few sleeps, the threshold is recomputed every this many sleeps. Zero is treated as one.
+         */
+        unsigned recalibrateEvery = 16;
+    };
+
+    /**
+     * Sleeps until a deadline with microsecond accuracy.
+     *
+     * The kernel wakes a sleeping thread late, typically by tens of microseconds and occasionally by much more.
+     * A PreciseSleeper sleeps through the kernel until a spin threshold before the deadline, then spins with
+     * cpuRelax for the rest. Every kernel sleep measures how late it woke, and the threshold follows the running
+     * histogram of those oversleeps, settling at the quantile that absorbs the kernel's wake-up latency on this
+     * machine without letting rare long descheduling events turn every sleep into a long spin.
+     *
+     * @note Deadlines are steady clock time points, as returned by SteadyClockBackend::now(). In MPI builds this is
+     * not the clock behind timer::now().
+     * @note A PreciseSleeper is not thread-safe. Use thisThreadSleeper() for a per-thread instance.
+     */
+    class PreciseSleeper {
+    public:
+        inline explicit PreciseSleeper(PreciseSleepOptions options = {})
+            : m_Options(options), m_Threshold(options.initialThreshold) {
+            m_Options.recalibrateEvery = std::max(m_Options.recalibrateEvery, 1u);
+        }
+
+        /**
+         * @brief Sleeps until the deadline.
+         * @param deadline The steady clock time point to wake at.
+         * @return How late the call returned. Never negative, and zero when the deadline had already passed.
+         */
+        inline Duration sleepUntil(TimePoint deadline) {
+            TimePoint current = SteadyClockBackend::now();
+            if (current >= deadline) {
+                return Duration(0.0);
+            }
+
+            if (deadline - current > m_Threshold) {
+                const TimePoint wakeTarget = deadline - m_Threshold;
+                std::this_thread::sleep_until(
+                    Clock::time_point(std::chrono::duration_cast<Clock::duration>(wakeTarget.time_since_epoch())));
+                current = SteadyClockBackend::now();
+                observe(current - wakeTarget);
+            }
+
+            while (current < deadline) {
+                cpuRelax();
+                current = SteadyClockBackend::now();
+            }
+            return current - deadline;
+        }
+
+        /**
+         * @brief Sleeps for a duration, measured from the call.
+         */
+        inline Duration sleepFor(Duration duration) {
+            return sleepUntil(SteadyClockBackend::now() + duration);
+        }
+
+        /**
+         * @return The current spin threshold.
+         */
+        inline Duration threshold() const { return m_Threshold; }
+
+        /**
+         * @return Every oversleep the kernel sleeps have measured so far.
+         */
+        inline const Histogram &oversleep() const { return m_Oversleep; }
+
+    private:
+        inline void observe(Duration oversleep) {
+            m_Oversleep.record(oversleep);
+
+            // Scanning the histogram costs a few microseconds, so only do it on every sleep while calibrating
+            const std::uint64_t observed = m_Oversleep.count();
+            if (observed <= m_Options.recalibrateEvery || observed % m_Options.recalibrateEvery == 0) {
+                m_Threshold = std::clamp(m_Oversleep.quantile(m_Options.quantile), m_Options.minThreshold,
+                                         m_Options.maxThreshold);
+            }
+        }
+
+        PreciseSleepOptions m_Options;
+        Duration m_Threshold;
+        Histogram m_Oversleep;
+    };
+
+    /**
+     * @return The calling thread's PreciseSleeper, which keeps its calibration across calls.
+     */
+    inline PreciseSleeper &thisThreadSleeper() {
+        thread_local PreciseSleeper sleeper;
+        return sleeper;
+    }
+
+    /**
+     * @brief Sleeps until a steady clock deadline, sleeping through the kernel for most of the interval and
+     * spin-waiting for the last part.
+     * @param deadline The steady clock time point to wake at, as from SteadyClockBackend::now().
+     * @return How late the call returned.
+     */
+    inline Duration sleep_until_precise(TimePoint deadline) {
+        return thisThreadSleeper().sleepUntil(deadline);
+    }
+
+    /**
+     * @brief Sleeps for a duration with the accuracy of sleep_until_precise.
+     */
+    inline Duration sleep_for_precise(Duration duration) {
+        return thisThreadSleeper().sleepFor(duration);
+    }
+}
+
+#endif //MCKRUEG_TIMER_SLEEP_HPP
@@ -0,0 +1,143 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_STATS_HPP
+#define MCKRUEG_TIMER_STATS_HPP
+#include "../timer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * Summary statistics of a set of duration samples.
+     * The median and MAD are robust to the outliers that scheduling noise produces, and should be preferred over the
+     * mean and standard deviation when comparing measurements.
+     */
+    struct SampleStats {
+        std::size_t count = 0;
+        Duration min{0.0};
+        Duration max{0.0};
+        Duration mean{0.0};
+        Duration median{0.0};
+
+        /**
+         * The sample standard deviation.
+         */
+        Duration stddev{0.0};
+
+        /**
+         * The median absolute deviation from the median, unscaled.
+         */
+        Duration mad{0.0};
+    };
+
+    /**
+     * @brief Returns the q-quantile of sorted samples, interpolating linearly between neighbours.
+     * @param sorted Samples in ascending order.
+     * @param q The quantile, from 0 to 1.
+     * @return The quantile, or zero if there are no samples.
+     */
+    inline Duration quantileOfSorted(const std::vector<Duration> &sorted, double q) {
+        if (sorted.empty()) {
+            return Duration(0.0);
+        }
+        const double position = std::clamp(q, 0.0, 1.0) * static_cast<double>(sorted.size() - 1);
+        const auto lower = static_cast<std::size_t>(position);
+        const std::size_t upper = std::min(lower + 1, sorted.size() - 1);
+        const double fraction = position - static_cast<double>(lower);
+        return sorted[lower] + (sorted[upper] - sorted[lower]) * fraction;
+    }
+
+    /**
+     * @brief Computes the summary statistics of a set of samples.
+     * @param samples The samples, in any order.
+     * @return The statistics. Every field is zero if there are no samples.
+     */
+    inline SampleStats summarize(std::vector<Duration> samples) {
+        SampleStats stats;
+        stats.count = samples.size();
+        if (samples.empty()) {
+            return stats;
+        }
+
+        std::sort(samples.begin(), samples.end());
+        stats.min = samples.front();
+        stats.max = samples.back();
+        stats.median = quantileOfSorted(samples, 0.5);
+
+        double sum = 0.0;
+        for (const Duration &sample: samples) {
+            sum += sample.count();
+        }
+        stats.mean = Duration(sum / static_cast<double>(samples.size()));
+
+        double squares = 0.0;
+        for (const Duration &sample: samples) {
+            const double deviation = sample.count() - stats.mean.count();
+            squares += deviation * deviation;
+        }
+        stats.stddev = Duration(samples.size() > 1 ? std::sqrt(squares / static_cast<double>(samples.size() - 1)) : 0.0);
+
+        for (Duration &sample: samples) {
+            sample = Duration(std::abs(sample.count() - stats.median.count()));
+        }
+        std::sort(samples.begin(), samples.end());
+        stats.mad = quantileOfSorted(samples, 0.5);
+
+        return stats;
+    }
+
+    /**
+     * @brief Returns the harmonic mean of a set of rates.
+     * This is the correct average of rates measured over equal amounts of work, such as the throughput of repeated
+     * runs of one benchmark: it equals the total work divided by the total time. The arithmetic mean of such rates
+     * overstates the throughput whenever the runs vary.
+     * @param rates The rates. Zero or negative rates are skipped.
+     * @return The harmonic mean, or zero if no rate is positive.
+     */
+    inline double harmonicMean(const std::vector<double> &rates) {
+        double reciprocals = 0.0;
+        std::size_t count = 0;
+        for (const double rate: rates) {
+            if (rate > 0.0) {
+                reciprocals += 1.0 / rate;
+                ++count;
+            }
+        }
+        return count > 0 ? static_cast<double>(count) / reciprocals : 0.0;
+    }
+}
+
+#endif //MCKRUEG_TIMER_STATS_HPP
@@ -0,0 +1,247 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_THREAD_POOL_HPP
+#define MCKRUEG_TIMER_THREAD_POOL_HPP
+#include "../timer.hpp"
+#include "platform.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * A fixed set of pinned worker threads for benchmarks and parallel timing.
+     *
+     * Creating threads for every measurement adds tens of microseconds of jitter and lets the scheduler scatter them
+     * across cores. The pool creates its workers once, pins each to a core, and dispatches to a specific worker through
+     * that worker's single task slot. Only the submitting thread writes a slot, and only its worker reads it.
+     *
+     * An idle worker spins for a while so that back-to-back dispatches are picked up within nanoseconds, then parks on
+     * a condition variable so an idle pool does not burn its cores.
+     *
+     * @note Each worker must be driven by one submitting thread at a time. A task passed to submit() is held by
+     * reference, and must stay alive until wait() for that worker returns.
+     */
+    class BenchmarkThreadPool {
+    public:
+        /**
+         * Starts the workers.
+         * @param workerCount The number of workers. Zero means one per allowed core.
+         * @param cores The cores to pin workers to, in order. Worker i is pinned to cores[i % cores.size()].
+         * Empty means the cores the calling thread may use (see allowedCores).
+         * @param spinBeforePark How long an idle worker spins before parking.
+         */
+        inline explicit BenchmarkThreadPool(unsigned workerCount = 0, std::vector<unsigned> cores = {},
+                                            Duration spinBeforePark = microseconds(200.0))
+            : m_SpinBeforePark(std::chrono::duration_cast<Clock::duration>(spinBeforePark)) {
+            if (cores.empty()) {
+                cores = allowedCores();
+            }
+            if (workerCount == 0) {
+                workerCount = static_cast<unsigned>(cores.size());
+            }
+
+            m_Workers.reserve(workerCount);
+            for (unsigned index = 0; index < workerCount; ++index) {
+                m_Workers.push_back(std::make_unique<Worker>());
+            }
+            for (unsigned index = 0; index < workerCount; ++index) {
+                const unsigned core = cores[index % cores.size()];
+                m_Workers[index]->thread = std::thread([this, index, core] { workerLoop(index, core); });
+            }
+        }
+
+        BenchmarkThreadPool(const BenchmarkThreadPool &) = delete;
+        BenchmarkThreadPool &operator=(const BenchmarkThreadPool &) = delete;
+
+        ~BenchmarkThreadPool() {
+            m_Stopping.store(true, std::memory_order_seq_cst);
+            for (const auto &worker: m_Workers) {
+                {
+                    std::lock_guard<std::mutex> lock(worker->mutex);
+                }
+                worker->wake.notify_one();
+            }
+            for (const auto &worker: m_Workers) {
+                worker->thread.join();
+            }
+        }
+
+        /**
+         * @return The number of workers.
+         */
+        inline unsigned size() const { return static_cast<unsigned>(m_Workers.size()); }
+
+        /**
+         * @brief Hands a task to a worker. The worker calls task(workerIndex), or task() if it takes no arguments.
+         * Waits for the worker's previous task first.
+         * @param worker The worker index.
+         * @param task The task. Held by reference until wait(worker) returns.
+         */
+        template<typename Task>
+        inline void submit(unsigned worker, Task &task) {
+            Worker &slot = *m_Workers[worker];
+            wait(worker);
+
+            slot.task = &task;
+            slot.invoke = [](void *erased, unsigned index) {
+                Task &typed = *static_cast<Task *>(erased);
+                if constexpr (std::is_invocable_v<Task &, unsigned>) {
+                    typed(index);
+                } else {
+                    typed();
+                }
+            };
+
+            // seq_cst pairs with the worker's parked flag, so either it sees the task or we see that it parked
+            const std::uint64_t sequence = slot.posted.load(std::memory_order_relaxed) + 1;
+            slot.posted.store(sequence, std::memory_order_seq_cst);
+            if (slot.parked.load(std::memory_order_seq_cst)) {
+                {
+                    std::lock_guard<std::mutex> lock(slot.mutex);
+                }
+                slot.wake.notify_one();
+            }
+        }
+
+        /**
+         * @brief Waits, spinning, until a worker has finished its most recent task.
+         * @param worker The worker index.
+         */
+        inline void wait(unsigned worker) {
+            const Worker &slot = *m_Workers[worker];
+            const std::uint64_t sequence = slot.posted.load(std::memory_order_relaxed);
+            spinUntil([&] { return slot.completed.load(std::memory_order_acquire) == sequence; });
+        }
+
+        /**
+         * @brief Waits until every worker has finished its most recent task.
+         */
+        inline void waitAll() {
+            for (unsigned worker = 0; worker < size(); ++worker) {
+                wait(worker);
+            }
+        }
+
+        /**
+         * @brief Runs the same task on the first workerCount workers and waits for all of them.
+         * @param task The task, called concurrently with each worker's index if it accepts one.
+         * @param workerCount The number of workers to use, at most size(). Zero means all of them.
+         */
+        template<typename Task>
+        inline void run(Task &task, unsigned workerCount = 0) {
+            workerCount = workerCount == 0 ? size() : std::min(workerCount, size());
+            for (unsigned worker = 0; worker < workerCount; ++worker) {
+                submit(worker, task);
+            }
+            for (unsigned worker = 0; worker < workerCount; ++worker) {
+                wait(worker);
+            }
+        }
+
+        /**
+         * @return True if the worker has stopped spinning and is blocked waiting for a task.
+         */
+        inline bool isParked(unsigned worker) const {
+            return m_Workers[worker]->parked.load(std::memory_order_acquire);
+        }
+
+    private:
+        struct alignas(64) Worker {
+            // Written by the submitter
+            std::atomic<std::uint64_t> posted{0};
+            void (*invoke)(void *, unsigned) = nullptr;
+            void *task = nullptr;
+
+            // Written by the worker, on its own cache line so that polling it does not disturb the slot
+            alignas(64) std::atomic<std::uint64_t> completed{0};
+            std::atomic<bool> parked{false};
+
+            std::mutex mutex;
+            std::condition_variable wake;
+            std::thread thread;
+        };
+
+        inline void workerLoop(unsigned index, unsigned core) {
+            pinThisThread(core);
+            Worker &slot = *m_Workers[index];
+            std::uint64_t seen = 0;
+
+            while (true) {
+                // Spin for new work, checking the clock only occasionally to keep the loop tight
+                const auto spinUntilTime = Clock::now() + m_SpinBeforePark;
+                unsigned spins = 0;
+                while (slot.posted.load(std::memory_order_acquire) == seen &&
+                       !m_Stopping.load(std::memory_order_relaxed)) {
+                    cpuRelax();
+                    if (++spins % 64 == 0 && Clock::now() >= spinUntilTime) {
+                        park(slot, seen);
+                    }
+                }
+
+                const std::uint64_t sequence = slot.posted.load(std::memory_order_acquire);
+                if (sequence == seen) {
+                    return; // stopping with no work pending
+                }
+                slot.invoke(slot.task, index);
+                seen = sequence;
+                slot.completed.store(sequence, std::memory_order_release);
+            }
+        }
+
+        inline void park(Worker &slot, std::uint64_t seen) {
+            slot.parked.store(true, std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> lock(slot.mutex);
+                slot.wake.wait(lock, [&] {
+                    return slot.posted.load(std::memory_order_seq_cst) != seen ||
+                           m_Stopping.load(std::memory_order_seq_cst);
+                });
+            }
+            slot.parked.store(false, std::memory_order_relaxed);
+        }
+
+        std::vector<std::unique_ptr<Worker> > m_Workers;
+        std::atomic<bool> m_Stopping{false};
+        Clock::duration m_SpinBeforePark;
+    };
+}
+
+#endif //MCKRUEG_TIMER_THREAD_POOL_HPP
@@ -0,0 +1,151 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_THROUGHPUT_HPP
+#define MCKRUEG_TIMER_THROUGHPUT_HPP
+#include "../timer.hpp"
+#include "stats.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * Which unit prefixes a rate is formatted with.
+     */
+    enum class UnitPrefix {
+        /**
+         * Powers of 1000: kB, MB, GB. The convention for bandwidth.
+         */
+        Decimal,
+
+        /**
+         * Powers of 1024: KiB, MiB, GiB. The convention for memory sizes.
+         */
+        Binary
+    };
+
+    /**
+     * The throughput of a benchmark, aggregated over its samples with the harmonic mean.
+     * Both rates are zero when no byte or item count was attached.
+     */
+    struct Throughput {
+        double bytesPerSecond = 0.0;
+        double itemsPerSecond = 0.0;
+
+        inline bool empty() const { return bytesPerSecond <= 0.0 && itemsPerSecond <= 0.0; }
+    };
+
+    /**
+     * @brief Aggregates the throughput of samples that each processed the same number of bytes and items.
+     * @param samples The sample durations.
+     * @param bytesPerSample The bytes processed by each sample, or zero.
+     * @param itemsPerSample The items processed by each sample, or zero.
+     */
+    inline Throughput throughputOf(const std::vector<Duration> &samples, std::uint64_t bytesPerSample,
+                                   std::uint64_t itemsPerSample) {
+        const auto rates = [&](std::uint64_t amount) {
+            std::vector<double> perSample;
+            perSample.reserve(samples.size());
+            for (const Duration &sample: samples) {
+                perSample.push_back(sample.count() > 0.0 ? static_cast<double>(amount) / sample.count() : 0.0);
+            }
+            return harmonicMean(perSample);
+        };
+
+        Throughput throughput;
+        throughput.bytesPerSecond = bytesPerSample > 0 ? rates(bytesPerSample) : 0.0;
+        throughput.itemsPerSecond = itemsPerSample > 0 ? rates(itemsPerSample) : 0.0;
+        return throughput;
+    }
+
+    /**
+     * @brief Formats a quantity with a unit prefix, to about three significant digits.
+     * @param value The quantity, in base units.
+     * @param unit The base unit, for example "B/s".
+     * @param prefix Decimal or binary prefixes.
+     * @return For example "1.23 GB/s" or "1.15 GiB/s".
+     */
+    inline std::string formatWithPrefix(double value, const char *unit, UnitPrefix prefix = UnitPrefix::Decimal) {
+        static const char *const decimal[] = {"", "k", "M", "G", "T", "P", "E"};
+        static const char *const binary[] = {"", "Ki", "Mi", "Gi", "Ti", "Pi", "Ei"};
+        const double step = prefix == UnitPrefix::Binary ? 1024.0 : 1000.0;
+
+        // Move up a prefix before the value would print as the step, so 999.9 B/s becomes 1.00 kB/s
+        std::size_t exponent = 0;
+        while (std::abs(value) >= step - 0.5 && exponent + 1 < std::size(decimal)) {
+            value /= step;
+            ++exponent;
+        }
+
+        const double magnitude = std::abs(value);
+        const int decimals = magnitude < 9.995 ? 2 : magnitude < 99.95 ? 1 : 0;
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%.*f %s%s", decimals, value,
+                      prefix == UnitPrefix::Binary ? binary[exponent] : decimal[exponent], unit);
+        return buffer;
+    }
+
+    /**
+     * @return A byte rate, such as "12.4 GB/s".
+     */
+    inline std::string formatBytesPerSecond(double bytesPerSecond, UnitPrefix prefix = UnitPrefix::Decimal) {
+        return formatWithPrefix(bytesPerSecond, "B/s", prefix);
+    }
+
+    /**
+     * @return An item rate with decimal prefixes, such as "3.50 Mitems/s".
+     */
+    inline std::string formatItemsPerSecond(double itemsPerSecond) {
+        return formatWithPrefix(itemsPerSecond, "items/s", UnitPrefix::Decimal);
+    }
+
+    /**
+     * @return Whichever rates are present, separated by a comma, or an empty string.
+     */
+    inline std::string formatThroughput(const Throughput &throughput, UnitPrefix prefix = UnitPrefix::Decimal) {
+        std::string text;
+        if (throughput.bytesPerSecond > 0.0) {
+            text = formatBytesPerSecond(throughput.bytesPerSecond, prefix);
+        }
+        if (throughput.itemsPerSecond > 0.0) {
+            text += (text.empty() ? "" : ", ") + formatItemsPerSecond(throughput.itemsPerSecond);
+        }
+        return text;
+    }
+}
+
+#endif //MCKRUEG_TIMER_THROUGHPUT_HPP
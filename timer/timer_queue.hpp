@@ -0,0 +1,227 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_TIMER_QUEUE_HPP
+#define MCKRUEG_TIMER_TIMER_QUEUE_HPP
+#include "../timer.hpp"
+#include "clocks.hpp"
+#include "timing_wheel.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace timer {
+
+    /**
+     * A link in an MpscQueue. Embed it in the queued object.
+     */
+    struct MpscHook {
+        std::atomic<MpscHook *> next{nullptr};
+    };
+
+    /**
+     * An intrusive, unbounded, lock-free multi-producer single-consumer queue (Vyukov's algorithm).
+     * push() is wait-free: a single atomic exchange and a store. pop() is lock-free and may only be called by one
+     * thread at a time. Each producer's pushes are popped in the order that producer made them.
+     *
+     * @note A hook must not be pushed again until it has been popped.
+     */
+    class MpscQueue {
+    public:
+        MpscQueue() = default;
+        MpscQueue(const MpscQueue &) = delete;
+        MpscQueue &operator=(const MpscQueue &) = delete;
+
+        /**
+         * @brief Appends a hook. Safe to call from any thread.
+         */
+        inline void push(MpscHook &hook) {
+            hook.next.store(nullptr, std::memory_order_relaxed);
+            MpscHook *previous = m_Head.exchange(&hook, std::memory_order_acq_rel);
+            previous->next.store(&hook, std::memory_order_release);
+        }
+
+        /**
+         * @brief Removes the oldest hook. Only the consumer thread may call this.
+         * @return The hook, or null if the queue is empty or a producer is midway through a push.
+         */
+        inline MpscHook *pop() {
+            MpscHook *tail = m_Tail;
+            MpscHook *next = tail->next.load(std::memory_order_acquire);
+            if (tail == &m_Stub) {
+                if (next == nullptr) {
+                    return nullptr;
+                }
+                m_Tail = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+            if (next != nullptr) {
+                m_Tail = next;
+                return tail;
+            }
+
+            // tail is the last hook, unless a producer has swapped the head but not linked it yet
+            if (tail != m_Head.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+            push(m_Stub);
+            next = tail->next.load(std::memory_order_acquire);
+            if (next != nullptr) {
+                m_Tail = next;
+                return tail;
+            }
+            return nullptr;
+        }
+
+    private:
+        MpscHook m_Stub;
+        std::atomic<MpscHook *> m_Head{&m_Stub};
+        MpscHook *m_Tail = &m_Stub;
+    };
+
+    /**
+     * A timer that any thread may schedule or cancel through a TimerQueue.
+     * Derive from it, or embed it, like a TimerNode.
+     *
+     * @note It must not be destroyed while a request is pending (see isRequestPending) or while it is scheduled.
+     */
+    class QueuedTimer : public TimerNode, private MpscHook {
+    public:
+        /**
+         * @return True if a schedule or cancel request has been made that the owner thread has not yet applied.
+         */
+        inline bool isRequestPending() const { return m_Queued.load(std::memory_order_acquire); }
+
+    private:
+        // Only the latest request matters, so the requested state is a single value and the hook is queued at most
+        // once. A deadline of negative infinity requests cancellation.
+        static constexpr double cancelRequest = -std::numeric_limits<double>::infinity();
+
+        std::atomic<double> m_RequestedDeadline{cancelRequest};
+        std::atomic<bool> m_Queued{false};
+
+        friend class TimerQueue;
+    };
+
+    /**
+     * A timer container owned by one thread, that other threads schedule into.
+     *
+     * Producers record the requested deadline on the timer and push it onto a lock-free MPSC queue. There is no mutex
+     * anywhere on the schedule or cancel path. Before each tick, the owner thread drains the queue in one batch into
+     * its TimingWheel. If a timer is rescheduled or cancelled several times before a drain, only the latest request
+     * is applied.
+     */
+    class TimerQueue {
+    public:
+        static_assert(std::atomic<MpscHook *>::is_always_lock_free, "the MPSC queue must be lock-free");
+        static_assert(std::atomic<double>::is_always_lock_free, "timer requests must be lock-free");
+
+        /**
+         * @param tickDuration The resolution of the owner's timing wheel.
+         * @param origin The time of the wheel's tick zero.
+         */
+        inline explicit TimerQueue(Duration tickDuration = milliseconds(1.0),
+                                   TimePoint origin = SteadyClockBackend::now())
+            : m_Wheel(tickDuration, origin) {}
+
+        /**
+         * @brief Requests that a timer expire at a deadline, replacing any earlier request. Safe to call from any thread.
+         */
+        inline void schedule(QueuedTimer &timer, TimePoint deadline) {
+            request(timer, deadline.time_since_epoch().count());
+        }
+
+        /**
+         * @brief Requests that a timer be cancelled. Safe to call from any thread.
+         * A timer that has already expired, or expires before the owner drains the request, still fires.
+         */
+        inline void cancel(QueuedTimer &timer) {
+            request(timer, QueuedTimer::cancelRequest);
+        }
+
+        /**
+         * @brief Applies every pending request to the wheel. Only the owner thread may call this.
+         * @return The number of requests applied.
+         */
+        inline std::size_t drain() {
+            std::size_t applied = 0;
+            while (MpscHook *hook = m_Requests.pop()) {
+                QueuedTimer &timer = static_cast<QueuedTimer &>(*hook);
+
+                // Clear the flag before reading the request, so a request made after this is queued again.
+                // The exchange acquires the producer's deadline store.
+                timer.m_Queued.exchange(false, std::memory_order_acq_rel);
+                const double deadline = timer.m_RequestedDeadline.load(std::memory_order_acquire);
+                if (deadline == QueuedTimer::cancelRequest) {
+                    m_Wheel.cancel(timer);
+                } else {
+                    m_Wheel.schedule(timer, TimePoint(Duration(deadline)));
+                }
+                ++applied;
+            }
+            return applied;
+        }
+
+        /**
+         * @brief Drains pending requests, then expires every timer due at or before a time. Owner thread only.
+         * @param currentTime The time to advance to.
+         * @param onExpired Called with each expired TimerNode&, which can be cast back to the QueuedTimer subclass.
+         * @return The number of expired timers.
+         */
+        template<typename Callback>
+        inline std::size_t advance(TimePoint currentTime, Callback &&onExpired) {
+            drain();
+            return m_Wheel.advance(currentTime, std::forward<Callback>(onExpired));
+        }
+
+        /**
+         * @return The owner's wheel, for direct use from the owner thread.
+         */
+        inline TimingWheel &wheel() { return m_Wheel; }
+
+        inline const TimingWheel &wheel() const { return m_Wheel; }
+
+    private:
+        inline void request(QueuedTimer &timer, double deadline) {
+            timer.m_RequestedDeadline.store(deadline, std::memory_order_release);
+            if (!timer.m_Queued.exchange(true, std::memory_order_acq_rel)) {
+                m_Requests.push(timer);
+            }
+        }
+
+        TimingWheel m_Wheel;
+        MpscQueue m_Requests;
+    };
+}
+
+#endif //MCKRUEG_TIMER_TIMER_QUEUE_HPP
@@ -0,0 +1,171 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_TIMERFD_DRIVER_HPP
+#define MCKRUEG_TIMER_TIMERFD_DRIVER_HPP
+#include "../timer.hpp"
+#include "clocks.hpp"
+#include "timing_wheel.hpp"
+
+// timerfd is Linux only. Elsewhere this header intentionally declares nothing.
+#if defined(__linux__)
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace timer {
+
+    /**
+     * Counts of the work a TimerfdDriver has done, for judging its syscall cost per expired timer.
+     */
+    struct TimerfdStats {
+        /**
+         * timerfd_settime calls, that is re-arms.
+         */
+        std::uint64_t settimeCalls = 0;
+
+        /**
+         * read calls on the timerfd.
+         */
+        std::uint64_t readCalls = 0;
+
+        /**
+         * Timers expired through onReadable.
+         */
+        std::uint64_t expired = 0;
+    };
+
+    /**
+     * Drives a TimingWheel from an epoll (or poll/select) loop with a single timerfd.
+     *
+     * The timerfd uses CLOCK_MONOTONIC with absolute deadlines (TFD_TIMER_ABSTIME), which is the clock behind
+     * std::chrono::steady_clock on Linux and therefore the wheel's clock. It is armed for the wheel's earliest
+     * deadline. It is only re-armed when that deadline moves earlier: a deadline that moves later, for example
+     * because the earliest timer was cancelled, leaves the timer armed, and the early wake-up re-arms it for free.
+     * When it fires, every due timer expires in one batch.
+     *
+     * Register fd() for EPOLLIN, call update() after scheduling, and call onReadable() when the fd is readable.
+     */
+    class TimerfdDriver {
+    public:
+        /**
+         * Creates the timerfd. Check valid() for failure.
+         * @param wheel The wheel to drive. It must outlive the driver.
+         */
+        inline explicit TimerfdDriver(TimingWheel &wheel)
+            : m_Wheel(wheel), m_Fd(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)) {}
+
+        TimerfdDriver(const TimerfdDriver &) = delete;
+        TimerfdDriver &operator=(const TimerfdDriver &) = delete;
+
+        ~TimerfdDriver() {
+            if (m_Fd >= 0) {
+                close(m_Fd);
+            }
+        }
+
+        /**
+         * @return The timerfd, to register with epoll for EPOLLIN. Negative if creation failed.
+         */
+        inline int fd() const { return m_Fd; }
+
+        inline bool valid() const { return m_Fd >= 0; }
+
+        /**
+         * @brief Re-arms the timerfd if the wheel's earliest deadline is now earlier than the armed one.
+         * Call after scheduling timers. Cancelling never requires it.
+         */
+        inline void update() {
+            const std::optional<TimePoint> next = m_Wheel.nextExpiry();
+            if (!next || m_Armed <= *next) {
+                return;
+            }
+            arm(*next);
+        }
+
+        /**
+         * @brief Handles the timerfd becoming readable: expires every due timer in one batch, then re-arms.
+         * @param onExpired Called with each expired TimerNode&.
+         * @return The number of expired timers.
+         */
+        template<typename Callback>
+        inline std::size_t onReadable(Callback &&onExpired) {
+            std::uint64_t expirations = 0;
+            ++m_Stats.readCalls;
+            if (read(m_Fd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN) {
+                return 0;
+            }
+
+            // Whatever was armed has now fired
+            m_Armed = TimePoint::max();
+            const std::size_t expired = m_Wheel.advance(SteadyClockBackend::now(), std::forward<Callback>(onExpired));
+            m_Stats.expired += expired;
+            update();
+            return expired;
+        }
+
+        inline const TimerfdStats &stats() const { return m_Stats; }
+
+    private:
+        inline void arm(TimePoint deadline) {
+            // An all zero it_value would disarm the timer, so a deadline at or before the epoch becomes 1 ns
+            const double sinceEpoch = std::max(deadline.time_since_epoch().count(), 1e-9);
+            double whole = 0.0;
+            const double fraction = std::modf(sinceEpoch, &whole);
+
+            itimerspec spec{};
+            spec.it_value.tv_sec = static_cast<time_t>(whole);
+            spec.it_value.tv_nsec = static_cast<long>(fraction * 1e9);
+            ++m_Stats.settimeCalls;
+            if (timerfd_settime(m_Fd, TFD_TIMER_ABSTIME, &spec, nullptr) == 0) {
+                m_Armed = deadline;
+            }
+        }
+
+        TimingWheel &m_Wheel;
+        int m_Fd;
+
+        /**
+         * The armed deadline, or TimePoint::max() when the timer is not armed.
+         */
+        TimePoint m_Armed = TimePoint::max();
+        TimerfdStats m_Stats;
+    };
+}
+
+#endif // __linux__
+
+#endif //MCKRUEG_TIMER_TIMERFD_DRIVER_HPP
@@ -0,0 +1,380 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_TIMING_WHEEL_HPP
+#define MCKRUEG_TIMER_TIMING_WHEEL_HPP
+#include "../timer.hpp"
+#include "clocks.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace timer {
+
+    class TimingWheel;
+
+    /**
+     * An intrusive timer, linked directly into a TimingWheel so that scheduling never allocates.
+     * Embed it in (or derive from) the object that owns the deadline, and recover that object in the expiry callback.
+     *
+     * @note A TimerNode must not be moved, copied or destroyed while it is scheduled. Cancel it first.
+     */
+    class TimerNode {
+    public:
+        TimerNode() = default;
+        TimerNode(const TimerNode &) = delete;
+        TimerNode &operator=(const TimerNode &) = delete;
+
+        /**
+         * @return True if the node is scheduled in a wheel and has not yet expired or been cancelled.
+         */
+        inline bool isScheduled() const { return m_Next != nullptr; }
+
+    private:
+        TimerNode *m_Prev = nullptr;
+        TimerNode *m_Next = nullptr;
+        std::uint64_t m_ExpiryTick = 0;
+        std::uint32_t m_Slot = 0;
+
+        friend class TimingWheel;
+    };
+
+    /**
+     * A hierarchical timing wheel: four levels of 256 slots, each level 256 times coarser than the one below.
+     *
+     * Deadlines are rounded up to whole ticks and never fire early, to within floating point rounding. Scheduling and cancelling are O(1). Advancing
+     * expires every timer due up to the given time, in deadline order between ticks, and skips runs of empty slots
+     * using per-level occupancy bitmaps. Timers further out than the wheel's range (2^32 ticks) are parked at the top
+     * level and re-placed as time advances.
+     *
+     * The wheel is keyed on the steady clock (SteadyClockBackend::now), the same clock std::this_thread::sleep_until
+     * and the Linux CLOCK_MONOTONIC use. It is not thread-safe.
+     */
+    class TimingWheel {
+    public:
+        static constexpr unsigned levels = 4;
+        static constexpr unsigned slotBits = 8;
+        static constexpr unsigned slotsPerLevel = 1u << slotBits;
+
+        /**
+         * @param tickDuration The resolution of the wheel. Deadlines are rounded up to a whole number of ticks.
+         * @param origin The time of tick zero.
+         */
+        inline explicit TimingWheel(Duration tickDuration = milliseconds(1.0),
+                                    TimePoint origin = SteadyClockBackend::now())
+            : m_TickDuration(tickDuration), m_Origin(origin) {
+            for (unsigned level = 0; level < levels; ++level) {
+                for (unsigned slot = 0; slot < slotsPerLevel; ++slot) {
+                    TimerNode &head = m_Slots[level][slot];
+                    head.m_Prev = &head;
+                    head.m_Next = &head;
+                }
+            }
+        }
+
+        TimingWheel(const TimingWheel &) = delete;
+        TimingWheel &operator=(const TimingWheel &) = delete;
+
+        /**
+         * @brief Schedules a node to expire at a deadline, rescheduling it if it was already scheduled.
+         * A deadline that has already passed expires on the next advance.
+         * @param node The node. It must not be scheduled in a different wheel.
+         * @param deadline When the node expires.
+         */
+        inline void schedule(TimerNode &node, TimePoint deadline) {
+            cancel(node);
+            node.m_ExpiryTick = std::max(tickAtOrAfter(deadline), m_CurrentTick + 1);
+            place(node);
+            ++m_Size;
+        }
+
+        /**
+         * @brief Cancels a node. Does nothing if the node is not scheduled.
+         * It is safe to cancel any node, including one due in the current batch, from an expiry callback.
+         */
+        inline void cancel(TimerNode &node) {
+            if (!node.isScheduled()) {
+                return;
+            }
+            unlink(node);
+            --m_Size;
+        }
+
+        /**
+         * @brief Expires every node due at or before a time, in batches per tick.
+         * Callbacks may schedule and cancel nodes, including the one being expired.
+         * @param currentTime The time to advance to. Moving backwards does nothing.
+         * @param onExpired Called with each expired TimerNode&, which is no longer scheduled when it is called.
+         * @return The number of expired nodes.
+         */
+        template<typename Callback>
+        inline std::size_t advance(TimePoint currentTime, Callback &&onExpired) {
+            const std::uint64_t target = tickAtOrBefore(currentTime);
+            std::size_t expired = 0;
+
+            while (m_CurrentTick < target) {
+                // Skip straight to the next occupied level 0 slot or the next cascade, whichever comes first
+                const std::uint64_t next = m_CurrentTick + 1;
+                const unsigned index = static_cast<unsigned>(next & (slotsPerLevel - 1));
+                if (index != 0) {
+                    const int occupied = nextOccupied(0, index);
+                    const std::uint64_t nextBlock = (next | (slotsPerLevel - 1)) + 1;
+                    const std::uint64_t jumpTo = occupied < 0
+                                                     ? nextBlock
+                                                     : next + (static_cast<unsigned>(occupied) - index);
+                    if (jumpTo > target) {
+                        m_CurrentTick = target;
+                        break;
+                    }
+                    if (jumpTo > next) {
+                        m_CurrentTick = jumpTo - 1;
+                        continue;
+                    }
+                }
+
+                m_CurrentTick = next;
+                if (index == 0) {
+                    cascade();
+                }
+                expired += expireSlot(index, onExpired);
+            }
+            return expired;
+        }
+
+        /**
+         * @return A lower bound on the earliest deadline, or nothing if no node is scheduled. It is exact for deadlines
+         * within 256 ticks. A farther one is reported as the time its slot cascades, after which this can be asked again.
+         */
+        inline std::optional<TimePoint> nextExpiry() const {
+            if (m_Size == 0) {
+                return std::nullopt;
+            }
+
+            std::optional<std::uint64_t> earliest;
+            for (unsigned level = 0; level < levels; ++level) {
+                const unsigned shift = level * slotBits;
+                const std::uint64_t position = m_CurrentTick >> shift;
+                const unsigned start = static_cast<unsigned>((position + 1) & (slotsPerLevel - 1));
+
+                int occupied = nextOccupied(level, start);
+                if (occupied < 0 && start != 0) {
+                    occupied = nextOccupied(level, 0);
+                }
+                if (occupied < 0) {
+                    continue;
+                }
+
+                const std::uint64_t distance = (static_cast<unsigned>(occupied) - start) & (slotsPerLevel - 1);
+                const std::uint64_t tick = (position + 1 + distance) << shift;
+                if (!earliest || tick < *earliest) {
+                    earliest = tick;
+                }
+            }
+            return earliest ? std::optional<TimePoint>(timeOfTick(*earliest)) : std::nullopt;
+        }
+
+        /**
+         * @return The number of scheduled nodes.
+         */
+        inline std::size_t size() const { return m_Size; }
+
+        inline bool empty() const { return m_Size == 0; }
+
+        inline Duration tickDuration() const { return m_TickDuration; }
+
+        /**
+         * @return The time up to which the wheel has been advanced, rounded down to a tick.
+         */
+        inline TimePoint currentTime() const { return timeOfTick(m_CurrentTick); }
+
+    private:
+        // Marks a node detached from its slot for expiry, so cancelling it does not touch the bitmaps
+        static constexpr std::uint32_t expiringSlot = ~std::uint32_t{0};
+
+        // TimePoint is double precision, so a time exactly on a tick may come out a hair either side of it.
+        // Times within this fraction of a tick are treated as on it.
+        static constexpr double tickTolerance = 1e-3;
+
+        inline std::uint64_t tickAtOrAfter(TimePoint time) const {
+            const double ticks = std::ceil((time - m_Origin) / m_TickDuration - tickTolerance);
+            return ticks <= 0.0 ? 0 : static_cast<std::uint64_t>(ticks);
+        }
+
+        inline std::uint64_t tickAtOrBefore(TimePoint time) const {
+            const double ticks = std::floor((time - m_Origin) / m_TickDuration + tickTolerance);
+            return ticks <= 0.0 ? 0 : static_cast<std::uint64_t>(ticks);
+        }
+
+        inline TimePoint timeOfTick(std::uint64_t tick) const {
+            return m_Origin + m_TickDuration * static_cast<double>(tick);
+        }
+
+        inline void place(TimerNode &node) {
+            // Beyond the wheel's range, park at the farthest top level slot and re-place on cascade
+            constexpr std::uint64_t range = std::uint64_t{1} << (levels * slotBits);
+            const std::uint64_t delta = std::min(node.m_ExpiryTick - m_CurrentTick, range - 1);
+            const std::uint64_t placeTick = m_CurrentTick + delta;
+
+            unsigned level = 0;
+            while (level + 1 < levels && delta >= (std::uint64_t{1} << ((level + 1) * slotBits))) {
+                ++level;
+            }
+            const unsigned slot = static_cast<unsigned>((placeTick >> (level * slotBits)) & (slotsPerLevel - 1));
+
+            TimerNode &head = m_Slots[level][slot];
+            node.m_Prev = head.m_Prev;
+            node.m_Next = &head;
+            head.m_Prev->m_Next = &node;
+            head.m_Prev = &node;
+            node.m_Slot = level * slotsPerLevel + slot;
+            m_Occupied[level][slot / 64] |= std::uint64_t{1} << (slot % 64);
+        }
+
+        inline void unlink(TimerNode &node) {
+            node.m_Prev->m_Next = node.m_Next;
+            node.m_Next->m_Prev = node.m_Prev;
+            if (node.m_Slot != expiringSlot) {
+                const unsigned level = node.m_Slot / slotsPerLevel;
+                const unsigned slot = node.m_Slot % slotsPerLevel;
+                const TimerNode &head = m_Slots[level][slot];
+                if (head.m_Next == &head) {
+                    m_Occupied[level][slot / 64] &= ~(std::uint64_t{1} << (slot % 64));
+                }
+            }
+            node.m_Prev = nullptr;
+            node.m_Next = nullptr;
+        }
+
+        /**
+         * Moves every node of a slot onto a detached list headed by detached, and marks the slot empty.
+         */
+        inline void detachSlot(unsigned level, unsigned slot, TimerNode &detached) {
+            TimerNode &head = m_Slots[level][slot];
+            if (head.m_Next == &head) {
+                detached.m_Prev = &detached;
+                detached.m_Next = &detached;
+                return;
+            }
+            detached.m_Next = head.m_Next;
+            detached.m_Prev = head.m_Prev;
+            detached.m_Next->m_Prev = &detached;
+            detached.m_Prev->m_Next = &detached;
+            head.m_Prev = &head;
+            head.m_Next = &head;
+            m_Occupied[level][slot / 64] &= ~(std::uint64_t{1} << (slot % 64));
+        }
+
+        /**
+         * Re-places the nodes of the higher level slots that begin at the current tick, highest resolution first.
+         */
+        inline void cascade() {
+            for (unsigned level = 1; level < levels; ++level) {
+                const unsigned slot = static_cast<unsigned>((m_CurrentTick >> (level * slotBits)) & (slotsPerLevel - 1));
+
+                TimerNode detached;
+                detachSlot(level, slot, detached);
+                while (detached.m_Next != &detached) {
+                    TimerNode &node = *detached.m_Next;
+                    detached.m_Next = node.m_Next;
+                    node.m_Next->m_Prev = &detached;
+                    place(node);
+                }
+                detached.m_Prev = nullptr;
+                detached.m_Next = nullptr;
+
+                if (slot != 0) {
+                    break;
+                }
+            }
+        }
+
+        template<typename Callback>
+        inline std::size_t expireSlot(unsigned slot, Callback &onExpired) {
+            TimerNode detached;
+            detachSlot(0, slot, detached);
+            for (TimerNode *node = detached.m_Next; node != &detached; node = node->m_Next) {
+                node->m_Slot = expiringSlot;
+            }
+
+            std::size_t expired = 0;
+            while (detached.m_Next != &detached) {
+                TimerNode &node = *detached.m_Next;
+                unlink(node);
+                --m_Size;
+                ++expired;
+                onExpired(node);
+            }
+            detached.m_Prev = nullptr;
+            detached.m_Next = nullptr;
+            return expired;
+        }
+
+        /**
+         * @return The first occupied slot of a level at or after from, or -1 if there is none before the end.
+         */
+        inline int nextOccupied(unsigned level, unsigned from) const {
+            for (unsigned word = from / 64; word < slotsPerLevel / 64; ++word) {
+                std::uint64_t bits = m_Occupied[level][word];
+                if (word == from / 64) {
+                    bits &= ~std::uint64_t{0} << (from % 64);
+                }
+                if (bits != 0) {
+                    return static_cast<int>(word * 64 + lowestBit(bits));
+                }
+            }
+            return -1;
+        }
+
+        static inline unsigned lowestBit(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+            unsigned index = 0;
+            while ((bits & 1u) == 0) {
+                bits >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+
+        Duration m_TickDuration;
+        TimePoint m_Origin;
+        std::uint64_t m_CurrentTick = 0;
+        std::size_t m_Size = 0;
+        TimerNode m_Slots[levels][slotsPerLevel];
+        std::uint64_t m_Occupied[levels][slotsPerLevel / 64] = {};
+    };
+}
+
+#endif //MCKRUEG_TIMER_TIMING_WHEEL_HPP
@@ -0,0 +1,291 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+
+#pragma once
+#ifndef MCKRUEG_TIMER_TRACE_HPP
+#define MCKRUEG_TIMER_TRACE_HPP
+#include "../timer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace timer {
+
+    /**
+     * A single traced interval. The layout is fixed size and trivially copyable so that buffers can be written to a
+     * trace file as-is.
+     */
+    struct TraceEvent {
+        /**
+         * The name of the event, truncated to fit and always null terminated.
+         */
+        char name[48];
+
+        /**
+         * Start and end, in seconds on the measurement clock (see timer::now).
+         * Merged trace files store them on the reference rank's timeline instead.
+         */
+        double start;
+        double end;
+
+        /**
+         * The library assigned id of the thread that emitted the event.
+         */
+        std::uint32_t thread;
+
+        /**
+         * The MPI rank that emitted the event. Zero outside of merged trace files.
+         */
+        std::uint32_t rank;
+    };
+
+    /**
+     * The header at the start of a merged trace file.
+     * It is followed by rankCount TraceIndexEntry records and then the events of every rank.
+     * All fields are in the byte order of the machine that wrote the file.
+     */
+    struct TraceFileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t rankCount;
+        std::uint64_t eventSize;
+    };
+
+    /**
+     * Locates one rank's events within a merged trace file.
+     */
+    struct TraceIndexEntry {
+        /**
+         * Byte offset of the rank's first event from the start of the file.
+         */
+        std::uint64_t offset;
+
+        /**
+         * The number of events the rank wrote.
+         */
+        std::uint64_t count;
+    };
+
+    inline constexpr char traceFileMagic[8] = {'S', 'T', 'T', 'R', 'A', 'C', 'E', '\0'};
+    inline constexpr std::uint32_t traceFileVersion = 1;
+
+    /**
+     * @return A small, stable id for the calling thread, assigned in order of first use.
+     */
+    inline std::uint32_t traceThreadId() {
+        static std::atomic<std::uint32_t> nextId{0};
+        thread_local const std::uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    /**
+     * A fixed capacity ring buffer of trace events. Once full, the oldest events are overwritten.
+     *
+     * @note A TraceBuffer has a single writer. Give every thread its own buffer rather than sharing one.
+     */
+    class TraceBuffer {
+    public:
+        /**
+         * @param capacity The maximum number of events retained.
+         */
+        inline explicit TraceBuffer(std::size_t capacity = 65536) : m_Events(capacity > 0 ? capacity : 1) {}
+
+        /**
+         * Records an event. Does nothing while the buffer is disabled.
+         * @param name The event name. Longer names are truncated.
+         * @param start The start of the event.
+         * @param end The end of the event.
+         */
+        inline void emit(const char *name, TimePoint start, TimePoint end) {
+            if (!m_Enabled) {
+                return;
+            }
+
+            TraceEvent &event = m_Events[m_Next];
+            std::strncpy(event.name, name, sizeof(event.name) - 1);
+            event.name[sizeof(event.name) - 1] = '\0';
+            event.start = start.time_since_epoch().count();
+            event.end = end.time_since_epoch().count();
+            event.thread = traceThreadId();
+            event.rank = 0;
+
+            m_Next = m_Next + 1 == m_Events.size() ? 0 : m_Next + 1;
+            ++m_Emitted;
+        }
+
+        /**
+         * Enables or disables recording. A disabled buffer costs a single branch per emit.
+         */
+        inline void setEnabled(bool enabled) { m_Enabled = enabled; }
+
+        inline bool isEnabled() const { return m_Enabled; }
+
+        /**
+         * @return The number of events currently retained.
+         */
+        inline std::size_t size() const {
+            return m_Emitted < m_Events.size() ? static_cast<std::size_t>(m_Emitted) : m_Events.size();
+        }
+
+        inline std::size_t capacity() const { return m_Events.size(); }
+
+        /**
+         * @return The number of events overwritten because the buffer was full.
+         */
+        inline std::uint64_t dropped() const { return m_Emitted - size(); }
+
+        /**
+         * @return A copy of the retained events, oldest first.
+         */
+        inline std::vector<TraceEvent> events() const {
+            std::vector<TraceEvent> ordered;
+            ordered.reserve(size());
+            const std::size_t first = m_Emitted < m_Events.size() ? 0 : m_Next;
+            for (std::size_t i = 0; i < size(); ++i) {
+                ordered.push_back(m_Events[(first + i) % m_Events.size()]);
+            }
+            return ordered;
+        }
+
+        /**
+         * Discards every retained event.
+         */
+        inline void clear() {
+            m_Next = 0;
+            m_Emitted = 0;
+        }
+
+    private:
+        std::vector<TraceEvent> m_Events;
+        std::size_t m_Next = 0;
+        std::uint64_t m_Emitted = 0;
+        bool m_Enabled = true;
+    };
+
+    /**
+     * Emits an event covering its own lifetime into a TraceBuffer.
+     *
+     * @note The name is copied when the event is emitted, so it must stay valid until the ScopedTrace is destroyed.
+     */
+    class ScopedTrace {
+    public:
+        inline ScopedTrace(TraceBuffer &buffer, const char *name)
+            : m_Buffer(buffer), m_Name(name), m_Start(now()) {}
+
+        ScopedTrace(const ScopedTrace &) = delete;
+        ScopedTrace &operator=(const ScopedTrace &) = delete;
+
+        ~ScopedTrace() {
+            m_Buffer.emit(m_Name, m_Start, now());
+        }
+
+    private:
+        TraceBuffer &m_Buffer;
+        const char *m_Name;
+        TimePoint m_Start;
+    };
+
+    /**
+     * Reads a merged trace file written by writeMergedTrace.
+     * @param path The file to read.
+     * @param index If not null, receives the per-rank index.
+     * @return Every event in the file, grouped by rank. Empty if the file is missing, is not a trace file, or is
+     * truncated or corrupt.
+     */
+    inline std::vector<TraceEvent> readMergedTrace(const std::string &path, std::vector<TraceIndexEntry> *index = nullptr) {
+        std::vector<TraceEvent> events;
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            return events;
+        }
+        const auto fileSize = static_cast<std::uint64_t>(in.tellg());
+        in.seekg(0);
+
+        TraceFileHeader header{};
+        if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, traceFileMagic, sizeof(header.magic)) != 0 ||
+            header.version != traceFileVersion || header.eventSize != sizeof(TraceEvent)) {
+            return events;
+        }
+
+        // Every size read from the file is checked against the file's length before anything is allocated
+        const std::uint64_t dataOffset =
+                sizeof(TraceFileHeader) + static_cast<std::uint64_t>(header.rankCount) * sizeof(TraceIndexEntry);
+        if (dataOffset > fileSize) {
+            return events;
+        }
+
+        std::vector<TraceIndexEntry> entries(header.rankCount);
+        if (!in.read(reinterpret_cast<char *>(entries.data()),
+                     static_cast<std::streamsize>(entries.size() * sizeof(TraceIndexEntry)))) {
+            return events;
+        }
+
+        std::uint64_t total = 0;
+        for (const TraceIndexEntry &entry: entries) {
+            if (entry.offset < dataOffset || entry.offset > fileSize ||
+                entry.count > (fileSize - entry.offset) / sizeof(TraceEvent)) {
+                return events;
+            }
+            total += entry.count;
+        }
+        // The ranks' events do not overlap, so together they fit in the data section
+        if (total > (fileSize - dataOffset) / sizeof(TraceEvent)) {
+            return events;
+        }
+        events.reserve(static_cast<std::size_t>(total));
+
+        for (const TraceIndexEntry &entry: entries) {
+            const std::size_t first = events.size();
+            events.resize(first + entry.count);
+            in.seekg(static_cast<std::streamoff>(entry.offset));
+            in.read(reinterpret_cast<char *>(events.data() + first),
+                    static_cast<std::streamsize>(entry.count * sizeof(TraceEvent)));
+        }
+
+        // a truncated file is treated like an unreadable one
+        if (!in) {
+            events.clear();
+            return events;
+        }
+
+        if (index != nullptr) {
+            *index = std::move(entries);
+        }
+        return events;
+    }
+}
+
+#endif //MCKRUEG_TIMER_TRACE_HPP
@@ -0,0 +1,59 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Checks every clock backend for skew and backward jumps between cores: simple-timer-clockcheck [rounds] [cores...]
+// Exits with 1 if any backend is inconsistent, and with 2 if fewer than two cores were given or the threads could not
+// be pinned, so nothing was checked.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "timer/clock_check.hpp"
+
+int main(int argc, char **argv) {
+    timer::ClockCheckOptions options;
+    if (argc > 1) {
+        options.rounds = std::strtoull(argv[1], nullptr, 10);
+    }
+    for (int i = 2; i < argc; ++i) {
+        options.cores.push_back(static_cast<unsigned>(std::atoi(argv[i])));
+    }
+
+    bool consistent = true;
+    bool conclusive = true;
+    for (const timer::ClockCheckResult &result: timer::checkClocks(options)) {
+        timer::printClockCheck(std::cout, result);
+        std::cout << '\n';
+        conclusive = conclusive && result.conclusive();
+        consistent = consistent && (!result.conclusive() || result.consistent());
+    }
+    if (!consistent) {
+        return 1;
+    }
+    return conclusive ? 0 : 2;
+}
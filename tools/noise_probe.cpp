@@ -0,0 +1,56 @@
+/* *********************************************************************************************************************
+ * Copyright 2026 Matthew Krueger <contact@matthewkrueger.com>
+ * Original Source: https://github.com/Matthew-Krueger/simple-timer
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESSFOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************/
+
+// Measures the machine's own noise on every core: simple-timer-noise [seconds] [threshold_us] [tsc|steady]
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "timer/noise.hpp"
+
+template<typename Backend>
+static int probe(const timer::NoiseOptions &options) {
+    timer::NoiseProbe<Backend> noise(options);
+    std::cout << "spinning on " << Backend::name << " for " << options.duration.count() << " s, threshold "
+              << timer::microseconds(options.threshold).count() << " us\n";
+    timer::printNoiseReport(std::cout, noise.run());
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    timer::NoiseOptions options;
+    options.duration = timer::Duration(argc > 1 ? std::atof(argv[1]) : 1.0);
+    options.threshold = timer::microseconds(argc > 2 ? std::atof(argv[2]) : 1.0);
+    const bool steady = argc > 3 && std::strcmp(argv[3], "steady") == 0;
+
+    if (steady || !timer::TscClockBackend::available) {
+        return probe<timer::SteadyClockBackend>(options);
+    }
+    return probe<timer::TscClockBackend>(options);
+}